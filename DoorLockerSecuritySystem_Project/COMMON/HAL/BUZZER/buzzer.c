@@ -14,20 +14,20 @@
 void Buzzer_init(void)
 {
 	/* setting the buzzer pin as output pin */
-	GPIO_setupPinDirection(BUZZER_PORT,BUZZER_PIN,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(BUZZER_PORT,BUZZER_PIN,PIN_OUTPUT);
 
 	/* turning the buzzer off at first */
-	GPIO_writePin(BUZZER_PORT,BUZZER_PIN,LOGIC_LOW);
+	GPIO_WRITE_PIN(BUZZER_PORT,BUZZER_PIN,LOGIC_LOW);
 }
 
 void Buzzer_off(void)
 {
 	/* disabling the buzzer */
-	GPIO_writePin(BUZZER_PORT,BUZZER_PIN,LOGIC_LOW);
+	GPIO_WRITE_PIN(BUZZER_PORT,BUZZER_PIN,LOGIC_LOW);
 }
 
 void Buzzer_on(void)
 {
 	/* enabling the buzzer */
-	GPIO_writePin(BUZZER_PORT,BUZZER_PIN,LOGIC_HIGH);
+	GPIO_WRITE_PIN(BUZZER_PORT,BUZZER_PIN,LOGIC_HIGH);
 }
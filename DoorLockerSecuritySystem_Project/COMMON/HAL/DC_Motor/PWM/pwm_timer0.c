@@ -27,5 +27,5 @@ void PWM_Timer0_Start(uint8 duty_cycle)
 	OCR0 = duty_cycle ;
 
 	/* setting PB3/OC0 as output pin, this pin where the PWM signal is generated from MC. */
-	GPIO_setupPinDirection(PORTB_ID,PIN3_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(PORTB_ID,PIN3_ID,PIN_OUTPUT);
 }
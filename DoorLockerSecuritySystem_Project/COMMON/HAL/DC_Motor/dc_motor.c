@@ -12,12 +12,12 @@
 void DcMotor_init(void)
 {
 	/* setting the two motor pins as output */
-	GPIO_setupPinDirection(MOTOR_PORT,MOTOR_IN1,PIN_OUTPUT);
-	GPIO_setupPinDirection(MOTOR_PORT,MOTOR_IN2,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(MOTOR_PORT,MOTOR_IN1,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(MOTOR_PORT,MOTOR_IN2,PIN_OUTPUT);
 
 	/* stopping the motor */
-	GPIO_writePin(MOTOR_PORT,MOTOR_IN1,LOGIC_LOW);
-	GPIO_writePin(MOTOR_PORT,MOTOR_IN2,LOGIC_LOW);
+	GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN1,LOGIC_LOW);
+	GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN2,LOGIC_LOW);
 }
 
 void DcMotor_Rotate(DcMotor_State state,uint8 speed)
@@ -29,14 +29,14 @@ void DcMotor_Rotate(DcMotor_State state,uint8 speed)
 		PWM_Timer0_Start(speed);
 
 		/* setting direction of the motor to stop */
-		GPIO_writePin(MOTOR_PORT,MOTOR_IN1,LOGIC_LOW);
-		GPIO_writePin(MOTOR_PORT,MOTOR_IN2,LOGIC_LOW);
+		GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN1,LOGIC_LOW);
+		GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN2,LOGIC_LOW);
 		break;
 
 	case CW:
 		/* setting direction of the motor to rotate clockwise */
-		GPIO_writePin(MOTOR_PORT,MOTOR_IN1,LOGIC_HIGH);
-		GPIO_writePin(MOTOR_PORT,MOTOR_IN2,LOGIC_LOW);
+		GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN1,LOGIC_HIGH);
+		GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN2,LOGIC_LOW);
 
 		/* setting "speed = duty cycle" by which the motor rotates */
 		PWM_Timer0_Start(speed);
@@ -44,8 +44,8 @@ void DcMotor_Rotate(DcMotor_State state,uint8 speed)
 
 	case A_CW:
 		/* setting direction of the motor to rotate anti-clockwise */
-		GPIO_writePin(MOTOR_PORT,MOTOR_IN1,LOGIC_LOW);
-		GPIO_writePin(MOTOR_PORT,MOTOR_IN2,LOGIC_HIGH);
+		GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN1,LOGIC_LOW);
+		GPIO_WRITE_PIN(MOTOR_PORT,MOTOR_IN2,LOGIC_HIGH);
 
 		/* setting "speed = duty cycle" by which the motor rotates */
 		PWM_Timer0_Start(speed);
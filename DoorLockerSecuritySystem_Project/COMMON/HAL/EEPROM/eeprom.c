@@ -0,0 +1,148 @@
+ /******************************************************************************
+ *
+ * Module: External EEPROM
+ *
+ * File Name: eeprom.c
+ *
+ * Description: Source file for the External EEPROM Memory
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+#include "eeprom.h"
+#include "../../MCAL/I2C/i2c.h"
+#include <util/delay.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Device address with R/W=0, we need to get A8 A9 A10 address bits from the memory location address */
+#define EEPROM_DEVICE_ADDRESS(u16addr) ((uint8)(0xA0 | (((u16addr) & 0x0700)>>7)))
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+/*
+ * Run the transaction on the TWI engine and wait until it ends.
+ */
+static uint8 EEPROM_transfer(TWI_Transaction *transaction);
+
+/*******************************************************************************
+*                       Functions Definitions                                  *
+*******************************************************************************/
+uint8 EEPROM_writeByte(uint16 u16addr, uint8 u8data)
+{
+	return EEPROM_writeBlock(u16addr, &u8data, 1);
+}
+
+uint8 EEPROM_readByte(uint16 u16addr, uint8 *u8data)
+{
+	return EEPROM_readBlock(u16addr, u8data, 1);
+}
+
+uint8 EEPROM_writeBlock(uint16 u16addr, const uint8 *data, uint16 size)
+{
+	/* The memory location address followed by the page bytes */
+	uint8 buffer[1 + EEPROM_PAGE_SIZE];
+	uint8 page_size, idx;
+	TWI_Transaction transaction;
+
+	transaction.read_data = NULL_PTR;
+	transaction.read_size = 0;
+	transaction.callBack = NULL_PTR;
+
+	while (size != 0)
+	{
+		/* The EEPROM address counter rolls over inside the page, so each write must end at the page end */
+		page_size = EEPROM_PAGE_SIZE - (u16addr & (EEPROM_PAGE_SIZE - 1));
+		if (page_size > size)
+		{
+			page_size = size;
+		}
+
+		buffer[0] = (uint8)u16addr;
+		for (idx = 0; idx < page_size; idx++)
+		{
+			buffer[1 + idx] = data[idx];
+		}
+
+		transaction.slave_address = EEPROM_DEVICE_ADDRESS(u16addr);
+		transaction.write_data = buffer;
+		transaction.write_size = 1 + page_size;
+
+		/* The EEPROM starts its internal write cycle after the Stop Bit */
+		if (EEPROM_transfer(&transaction) == ERROR)
+			return ERROR;
+
+		/* wait until the page is saved before writing the next one */
+		if (EEPROM_waitReady() == ERROR)
+			return ERROR;
+
+		data += page_size;
+		size -= page_size;
+		u16addr += page_size;
+	}
+
+	return SUCCESS;
+}
+
+uint8 EEPROM_readBlock(uint16 u16addr, uint8 *data, uint16 size)
+{
+	uint8 address = (uint8)u16addr;
+	TWI_Transaction transaction;
+
+	if (size == 0)
+		return SUCCESS;
+
+	/* Write the memory location address, then a repeated start and a sequential read:
+	 * the EEPROM increments its address counter after each byte */
+	transaction.slave_address = EEPROM_DEVICE_ADDRESS(u16addr);
+	transaction.write_data = &address;
+	transaction.write_size = 1;
+	transaction.read_data = data;
+	transaction.read_size = size;
+	transaction.callBack = NULL_PTR;
+
+	return EEPROM_transfer(&transaction);
+}
+
+uint8 EEPROM_waitReady(void)
+{
+	uint16 attempts;
+	TWI_Transaction transaction;
+
+	/* Only the device address, the transaction is done if the EEPROM acknowledges it */
+	transaction.slave_address = EEPROM_DEVICE_ADDRESS(0);
+	transaction.write_data = NULL_PTR;
+	transaction.write_size = 0;
+	transaction.read_data = NULL_PTR;
+	transaction.read_size = 0;
+	transaction.callBack = NULL_PTR;
+
+	for (attempts = 0; attempts < ((EEPROM_WRITE_TIMEOUT_MS * 1000UL) / EEPROM_POLL_INTERVAL_US); attempts++)
+	{
+		/* The EEPROM acknowledges its address only after the write cycle is done */
+		if (EEPROM_transfer(&transaction) == SUCCESS)
+			return SUCCESS;
+
+		/* A stuck bus is not a busy EEPROM, don't keep polling */
+		if (transaction.status == TWI_TRANSACTION_TIMEOUT)
+			return ERROR;
+
+		_delay_us(EEPROM_POLL_INTERVAL_US);
+	}
+
+	return ERROR;
+}
+
+/*******************************************************************************
+ *                      Private Functions Definitions                          *
+ *******************************************************************************/
+static uint8 EEPROM_transfer(TWI_Transaction *transaction)
+{
+	/* wait for a free place in the engine queue */
+	while (TWI_submit(transaction) == FALSE);
+
+	/* wait until the engine ends the transaction, it ends with a timeout if the bus is stuck */
+	return (TWI_waitTransaction(transaction) == TWI_TRANSACTION_DONE) ? SUCCESS : ERROR;
+}
@@ -0,0 +1,80 @@
+ /******************************************************************************
+ *
+ * Module: External EEPROM
+ *
+ * File Name: eeprom.h
+ *
+ * Description: Header file for the External EEPROM Memory
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+
+#ifndef EEPROM_H_
+#define EEPROM_H_
+
+#include "../../MCAL/std_types.h"
+
+/*******************************************************************************
+ *                              Definitions                                    *
+ *******************************************************************************/
+#define ERROR 0
+#define SUCCESS 1
+
+/* 24C16: 2K bytes in 8 blocks of 256 bytes, written in pages of 16 bytes */
+#define EEPROM_SIZE          2048
+#define EEPROM_PAGE_SIZE     16
+
+/*
+ * While the EEPROM is in its internal write cycle (tWR = 5ms max) it doesn't acknowledge
+ * its device address, so it is polled every EEPROM_POLL_INTERVAL_US until it acknowledges.
+ * The write is considered failed if it is not done within EEPROM_WRITE_TIMEOUT_MS.
+ */
+#define EEPROM_POLL_INTERVAL_US   50
+#define EEPROM_WRITE_TIMEOUT_MS   20
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * The functions below run their transactions on the interrupt driven TWI engine,
+ * so the I-bit must be enabled, and they wait until the transactions end.
+ * They return ERROR as soon as a transaction is not acknowledged or the bus is stuck
+ * for TWI_TIMEOUT_US (the bus is recovered in this case).
+ */
+
+/*
+ * Description :
+ * Write one byte, it returns after the write cycle is done.
+ */
+uint8 EEPROM_writeByte(uint16 u16addr,uint8 u8data);
+/*
+ * Description :
+ * Read one byte.
+ */
+uint8 EEPROM_readByte(uint16 u16addr,uint8 *u8data);
+
+/*
+ * Description :
+ * Write size bytes starting from u16addr, using one page write for every part
+ * of the data that lies in the same EEPROM page.
+ * It returns after the write cycle of the last page is done.
+ */
+uint8 EEPROM_writeBlock(uint16 u16addr,const uint8 *data,uint16 size);
+
+/*
+ * Description :
+ * Read size bytes starting from u16addr in one sequential read.
+ */
+uint8 EEPROM_readBlock(uint16 u16addr,uint8 *data,uint16 size);
+
+/*
+ * Description :
+ * Wait until the EEPROM finishes its internal write cycle by polling its device address.
+ * It returns ERROR if the EEPROM doesn't acknowledge within EEPROM_WRITE_TIMEOUT_MS.
+ */
+uint8 EEPROM_waitReady(void);
+ 
+#endif /* EXTERNAL_EEPROM_H_ */
@@ -0,0 +1,383 @@
+ /******************************************************************************
+ *
+ * Module: KEYPAD
+ *
+ * File Name: keypad.c
+ *
+ * Description: Source file for the Keypad driver
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+#include "keypad.h"
+#include <util/delay.h>
+#include <avr/cpufunc.h>           /* For _NOP */
+#include <avr/pgmspace.h>          /* To read the tables from the program memory */
+#include "../../MCAL/GPIO/gpio.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Bits of the keypad rows and columns in their ports */
+#define KEYPAD_ROWS_MASK  ((uint8)(((1 << KEYPAD_NUM_ROWS) - 1) << KEYPAD_FIRST_ROW_PIN_ID))
+#define KEYPAD_COLS_MASK  ((uint8)(((1 << KEYPAD_NUM_COLS) - 1) << KEYPAD_FIRST_COL_PIN_ID))
+
+/*******************************************************************************
+ *                      Type Declarations(Private)                             *
+ *******************************************************************************/
+
+/* Debounce states of each button */
+typedef enum
+{
+	KEYPAD_KEY_RELEASED,KEYPAD_KEY_PRESS_DEBOUNCE,KEYPAD_KEY_PRESSED,KEYPAD_KEY_RELEASE_DEBOUNCE
+}KEYPAD_KeyState;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+
+/* Index of the first pressed column for each value of the columns bits (bit = 1 for a pressed column) */
+static const uint8 g_firstColumn[16] PROGMEM =
+{
+	KEYPAD_NO_KEY,0,1,0,2,0,1,0,3,0,1,0,2,0,1,0
+};
+
+/* A bit is set for each button that is not in the released state */
+static uint16 g_activeButtons = 0;
+
+/* Debounce state and counter of each button */
+static KEYPAD_KeyState g_keyState[KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS];
+static uint8 g_keyCount[KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS];
+
+/*
+ * Key events queue: KEYPAD_scanTask is the only writer of g_eventHead and KEYPAD_getEvent
+ * is the only writer of g_eventTail, the queue is empty when they are equal.
+ */
+static volatile KEYPAD_Event g_eventQueue[KEYPAD_EVENT_QUEUE_SIZE];
+static volatile uint8 g_eventHead = 0;
+static volatile uint8 g_eventTail = 0;
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for mapping the switch number in the keypad to its key
+ */
+static uint8 KEYPAD_mapKey(uint8 button_number);
+
+/*
+ * Function responsible for setting up all the keypad pins as input pins
+ */
+static void KEYPAD_setupPins(void);
+
+/*
+ * Function responsible for driving one row and reading all the columns,
+ * it returns a bit = 1 for each pressed column
+ */
+static uint8 KEYPAD_readRow(uint8 row);
+
+#ifndef STANDARD_KEYPAD
+
+#if (KEYPAD_NUM_COLS == 3)
+/*
+ * Function responsible for mapping the switch number in the keypad to
+ * its corresponding functional number in the proteus for 4x3 keypad
+ */
+static uint8 KEYPAD_4x3_adjustKeyNumber(uint8 button_number);
+#elif (KEYPAD_NUM_COLS == 4)
+/*
+ * Function responsible for mapping the switch number in the keypad to
+ * its corresponding functional number in the proteus for 4x4 keypad
+ */
+static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number);
+#endif
+
+#endif /* STANDARD_KEYPAD */
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+uint8 KEYPAD_getPressedKey(void)
+{
+	uint8 key;
+
+	while((key = KEYPAD_getKey()) == KEYPAD_NO_KEY)
+	{
+		_delay_ms(5); /* Add small delay to fix CPU load issue in proteus */
+	}
+	return key;
+}
+
+uint8 KEYPAD_getKey(void)
+{
+	uint8 row,cols;
+
+	KEYPAD_setupPins();
+
+	for(row=0 ; row<KEYPAD_NUM_ROWS ; row++) /* loop for rows */
+	{
+		cols = KEYPAD_readRow(row);
+		if(cols != 0)
+		{
+			GPIO_DDR_REG(KEYPAD_ROW_PORT_ID) &= (uint8)~KEYPAD_ROWS_MASK;
+			return KEYPAD_mapKey((row*KEYPAD_NUM_COLS)+pgm_read_byte(&g_firstColumn[cols])+1);
+		}
+	}
+	GPIO_DDR_REG(KEYPAD_ROW_PORT_ID) &= (uint8)~KEYPAD_ROWS_MASK;
+	return KEYPAD_NO_KEY;
+}
+
+void KEYPAD_init(void)
+{
+	uint8 button;
+
+	KEYPAD_setupPins();
+
+	for(button = 0; button < KEYPAD_NUM_ROWS * KEYPAD_NUM_COLS; button++)
+	{
+		g_keyState[button] = KEYPAD_KEY_RELEASED;
+		g_keyCount[button] = 0;
+	}
+	g_activeButtons = 0;
+	g_eventHead = 0;
+	g_eventTail = 0;
+}
+
+void KEYPAD_scanTask(void)
+{
+	uint8 col,row,cols,button,next_head;
+	boolean pressed;
+	KEYPAD_EventType type;
+
+	for(row=0 ; row<KEYPAD_NUM_ROWS ; row++) /* loop for rows */
+	{
+		cols = KEYPAD_readRow(row);
+
+		/* Nothing to debounce in this row: no button is pressed now or before */
+		if((cols == 0) && (((g_activeButtons >> (row*KEYPAD_NUM_COLS)) & ((1 << KEYPAD_NUM_COLS) - 1)) == 0))
+		{
+			continue;
+		}
+
+		for(col=0 ; col<KEYPAD_NUM_COLS ; col++) /* loop for columns */
+		{
+			button = (row*KEYPAD_NUM_COLS)+col;
+			pressed = ((cols >> col) & 1);
+
+			/* Debounce: the button changes its state only after the same reading is kept for KEYPAD_DEBOUNCE_SCANS scans */
+			switch(g_keyState[button])
+			{
+			case KEYPAD_KEY_RELEASED:
+				if(pressed)
+				{
+					g_keyState[button] = KEYPAD_KEY_PRESS_DEBOUNCE;
+					g_keyCount[button] = 1;
+					g_activeButtons |= (uint16)(1 << button);
+				}
+				continue;
+
+			case KEYPAD_KEY_PRESS_DEBOUNCE:
+				if(!pressed)
+				{
+					g_keyState[button] = KEYPAD_KEY_RELEASED;
+					g_activeButtons &= (uint16)~(1 << button);
+					continue;
+				}
+				if(++g_keyCount[button] < KEYPAD_DEBOUNCE_SCANS)
+				{
+					continue;
+				}
+				g_keyState[button] = KEYPAD_KEY_PRESSED;
+				type = KEYPAD_PRESSED;
+				break;
+
+			case KEYPAD_KEY_PRESSED:
+				if(!pressed)
+				{
+					g_keyState[button] = KEYPAD_KEY_RELEASE_DEBOUNCE;
+					g_keyCount[button] = 1;
+				}
+				continue;
+
+			case KEYPAD_KEY_RELEASE_DEBOUNCE:
+			default:
+				if(pressed)
+				{
+					g_keyState[button] = KEYPAD_KEY_PRESSED;
+					continue;
+				}
+				if(++g_keyCount[button] < KEYPAD_DEBOUNCE_SCANS)
+				{
+					continue;
+				}
+				g_keyState[button] = KEYPAD_KEY_RELEASED;
+				g_activeButtons &= (uint16)~(1 << button);
+				type = KEYPAD_RELEASED;
+				break;
+			}
+
+			/* Queue the event, it is dropped if the queue is full */
+			next_head = (uint8)((g_eventHead + 1) & (KEYPAD_EVENT_QUEUE_SIZE - 1));
+			if(next_head != g_eventTail)
+			{
+				g_eventQueue[g_eventHead].key = KEYPAD_mapKey(button+1);
+				g_eventQueue[g_eventHead].type = type;
+				g_eventHead = next_head;
+			}
+		}
+	}
+	GPIO_DDR_REG(KEYPAD_ROW_PORT_ID) &= (uint8)~KEYPAD_ROWS_MASK;
+}
+
+boolean KEYPAD_getEvent(KEYPAD_Event *event)
+{
+	if(g_eventHead == g_eventTail)
+	{
+		return FALSE;
+	}
+	event->key = g_eventQueue[g_eventTail].key;
+	event->type = g_eventQueue[g_eventTail].type;
+	g_eventTail = (uint8)((g_eventTail + 1) & (KEYPAD_EVENT_QUEUE_SIZE - 1));
+	return TRUE;
+}
+
+/*
+ * Description :
+ * Setup all the keypad pins as input pins
+ */
+static void KEYPAD_setupPins(void)
+{
+	/* All rows and columns are inputs, a row becomes output only while it is scanned */
+	GPIO_DDR_REG(KEYPAD_ROW_PORT_ID) &= (uint8)~KEYPAD_ROWS_MASK;
+	GPIO_DDR_REG(KEYPAD_COL_PORT_ID) &= (uint8)~KEYPAD_COLS_MASK;
+
+	/* The rows output the pressed logic when they are outputs */
+#if(KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
+	GPIO_PORT_REG(KEYPAD_ROW_PORT_ID) &= (uint8)~KEYPAD_ROWS_MASK;
+#else
+	GPIO_PORT_REG(KEYPAD_ROW_PORT_ID) |= KEYPAD_ROWS_MASK;
+#endif
+}
+
+/*
+ * Description :
+ * Drive one row and read all the columns, return a bit = 1 for each pressed column
+ */
+static uint8 KEYPAD_readRow(uint8 row)
+{
+	uint8 cols;
+
+	/* Only this row is output, one masked write to the direction register */
+	GPIO_DDR_REG(KEYPAD_ROW_PORT_ID) = (GPIO_DDR_REG(KEYPAD_ROW_PORT_ID) & (uint8)~KEYPAD_ROWS_MASK)
+	                                   | (uint8)(1 << (KEYPAD_FIRST_ROW_PIN_ID + row));
+	_NOP(); /* let the input synchronizer take the new columns values */
+
+	/* One masked read for all the columns */
+	cols = (uint8)((GPIO_PIN_REG(KEYPAD_COL_PORT_ID) & KEYPAD_COLS_MASK) >> KEYPAD_FIRST_COL_PIN_ID);
+
+#if(KEYPAD_BUTTON_PRESSED == LOGIC_LOW)
+	cols ^= (uint8)((1 << KEYPAD_NUM_COLS) - 1);
+#endif
+	return cols;
+}
+
+/*
+ * Description :
+ * Get the key of the switch number in the keypad
+ */
+static uint8 KEYPAD_mapKey(uint8 button_number)
+{
+#if (KEYPAD_NUM_COLS == 3)
+	#ifdef STANDARD_KEYPAD
+		return button_number;
+	#else
+		return KEYPAD_4x3_adjustKeyNumber(button_number);
+	#endif
+#elif (KEYPAD_NUM_COLS == 4)
+	#ifdef STANDARD_KEYPAD
+		return button_number;
+	#else
+		return KEYPAD_4x4_adjustKeyNumber(button_number);
+	#endif
+#endif
+}
+
+#ifndef STANDARD_KEYPAD
+
+#if (KEYPAD_NUM_COLS == 3)
+/*
+ * Description :
+ * Update the keypad pressed button value with the correct one in keypad 4x3 shape
+ */
+static uint8 KEYPAD_4x3_adjustKeyNumber(uint8 button_number)
+{
+	uint8 keypad_button = 0;
+	switch(button_number)
+	{
+		case 10: keypad_button = '*'; // ASCII Code of *
+				 break;
+		case 11: keypad_button = 0;
+				 break;		
+		case 12: keypad_button = '#'; // ASCII Code of #
+				 break;
+		default: keypad_button = button_number;
+				break;
+	}
+	return keypad_button;
+} 
+
+#elif (KEYPAD_NUM_COLS == 4)
+
+/*
+ * Description :
+ * Update the keypad pressed button value with the correct one in keypad 4x4 shape
+ */
+static uint8 KEYPAD_4x4_adjustKeyNumber(uint8 button_number)
+{
+	uint8 keypad_button = 0;
+	switch(button_number)
+	{
+		case 1: keypad_button = 7;
+				break;
+		case 2: keypad_button = 4;
+				break;
+		case 3: keypad_button = 1;
+				break;
+		case 4: keypad_button = 13; // ASCII Code of Enter " on/c "
+				break;
+		case 5: keypad_button = 8;
+				break;
+		case 6: keypad_button = 5;
+				break;
+		case 7: keypad_button = 2;
+				break;
+		case 8: keypad_button = 0;
+				break;		
+		case 9: keypad_button = 9;
+				break;
+		case 10: keypad_button = 6;
+				break;
+		case 11: keypad_button = 3;
+				break;
+		case 12: keypad_button = '=';  /* ASCII Code of '=' */
+				break;
+		case 13: keypad_button = '%';  /* ASCII Code of '%' */
+				break;			
+		case 14: keypad_button = '*';  /* ASCII Code of '*' */
+				break;
+		case 15: keypad_button = '-';  /* ASCII Code of '-' */
+				break;
+		case 16: keypad_button = '+';  /* ASCII Code of '+' */
+				break;
+		default: keypad_button = button_number;
+				break;
+	}
+	return keypad_button;
+} 
+
+#endif
+
+#endif /* STANDARD_KEYPAD */
@@ -0,0 +1,107 @@
+ /******************************************************************************
+ *
+ * Module: KEYPAD
+ *
+ * File Name: keypad.h
+ *
+ * Description: Header file for the Keypad driver
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef KEYPAD_H_
+#define KEYPAD_H_
+
+#include "../../MCAL/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Keypad configurations for number of rows and columns */
+#define KEYPAD_NUM_COLS                   4
+#define KEYPAD_NUM_ROWS                   4
+
+/* Keypad Port Configurations */
+#define KEYPAD_ROW_PORT_ID                PORTB_ID
+#define KEYPAD_FIRST_ROW_PIN_ID           PIN4_ID
+
+#define KEYPAD_COL_PORT_ID                PORTC_ID
+#define KEYPAD_FIRST_COL_PIN_ID           PIN4_ID
+
+/* Keypad button logic configurations */
+#define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
+#define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
+
+/* Choosing the Keypad Enter button */
+#define KEYPAD_ENTER_KEY '%'
+
+/* Returned by KEYPAD_getKey when no button is pressed */
+#define KEYPAD_NO_KEY                    0xFF
+
+/* KEYPAD_scanTask should be called every KEYPAD_SCAN_PERIOD_MS,
+ * a button changes its state after KEYPAD_DEBOUNCE_SCANS scans with the same reading */
+#define KEYPAD_SCAN_PERIOD_MS            5
+#define KEYPAD_DEBOUNCE_SCANS            4
+
+/* Size of the key events queue, it should be a power of 2 and not more than 256 */
+#define KEYPAD_EVENT_QUEUE_SIZE          8
+
+#if((KEYPAD_EVENT_QUEUE_SIZE & (KEYPAD_EVENT_QUEUE_SIZE - 1)) || (KEYPAD_EVENT_QUEUE_SIZE > 256))
+#error "KEYPAD_EVENT_QUEUE_SIZE should be a power of 2 and not more than 256"
+#endif
+
+/*******************************************************************************
+ *                          Type Declarations                                  *
+ *******************************************************************************/
+typedef enum
+{
+	KEYPAD_PRESSED,KEYPAD_RELEASED
+}KEYPAD_EventType;
+
+typedef struct
+{
+	uint8 key;
+	KEYPAD_EventType type;
+}KEYPAD_Event;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Get the Keypad pressed button
+ */
+uint8 KEYPAD_getPressedKey(void);
+
+/*
+ * Description :
+ * Scan the Keypad once without waiting,
+ * return the pressed button or KEYPAD_NO_KEY if no button is pressed.
+ */
+uint8 KEYPAD_getKey(void);
+
+/*
+ * Description :
+ * Setup the Keypad pins directions and clear the key events queue.
+ */
+void KEYPAD_init(void);
+
+/*
+ * Description :
+ * Scan all the Keypad buttons once and run the debounce of each button,
+ * a key event is queued when a button is pressed or released.
+ * It should be called every KEYPAD_SCAN_PERIOD_MS, it is short enough to be called from a timer ISR.
+ */
+void KEYPAD_scanTask(void);
+
+/*
+ * Description :
+ * Take the oldest key event without waiting.
+ * Return TRUE if an event is written in event, otherwise return FALSE.
+ */
+boolean KEYPAD_getEvent(KEYPAD_Event *event);
+
+#endif /* KEYPAD_H_ */
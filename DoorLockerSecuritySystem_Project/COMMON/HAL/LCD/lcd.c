@@ -0,0 +1,545 @@
+ /******************************************************************************
+ *
+ * Module: LCD
+ *
+ * File Name: lcd.c
+ *
+ * Description: Source file for the LCD driver
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+#include "lcd.h"
+#include <util/delay.h>                /* For the delay functions */
+#include <avr/pgmspace.h>              /* To read the strings and tables from the program memory */
+#include "../../MCAL/GPIO/gpio.h"
+#include "../../MCAL/common_macros.h"  /* For GET_BIT Macro */
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* Only the clear and return home instructions take more than 1ms */
+#define LCD_IS_LONG_INSTRUCTION(value,rs_value) (((rs_value) == LOGIC_LOW) && (((value) & 0xFC) == 0))
+
+#ifdef LCD_ASYNC_MODE
+/* Number of LCD_task calls skipped after a long instruction */
+#define LCD_LONG_INSTRUCTION_TICKS ((LCD_LONG_EXECUTION_TIME_US + LCD_TASK_PERIOD_US - 1) / LCD_TASK_PERIOD_US)
+#endif
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+#ifdef LCD_ASYNC_MODE
+
+/*
+ * Output queue: each entry is the RS value in the high byte and the command or character in the low byte.
+ * The application is the only writer of g_queueHead and LCD_task is the only writer of g_queueTail,
+ * the queue is empty when they are equal.
+ */
+static volatile uint16 g_queue[LCD_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/* LCD_task calls left until the last long instruction is done */
+static volatile uint8 g_waitTicks = 0;
+
+#endif
+
+#ifdef LCD_SHADOW_MODE
+
+/* DDRAM address of the first character of each row */
+static const uint8 g_rowAddress[4] PROGMEM = {0x00,0x40,0x10,0x50};
+
+/* What the application wrote and what is shown on the screen now */
+static uint8 g_shadow[LCD_NUM_ROWS][LCD_NUM_COLS];
+static uint8 g_screen[LCD_NUM_ROWS][LCD_NUM_COLS];
+
+/* Cursor of the application in g_shadow */
+static uint8 g_cursorRow = 0;
+static uint8 g_cursorCol = 0;
+
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes(Private)                          *
+ *******************************************************************************/
+
+/*
+ * Function responsible for sending a command or a character to the LCD then waiting until it is done
+ */
+static void LCD_write(uint8 value, uint8 rs_value);
+
+/*
+ * Function responsible for sending a command or a character to the LCD without waiting
+ */
+static void LCD_writeBus(uint8 value, uint8 rs_value);
+
+/*
+ * Function responsible for queuing a command or a character in LCD_ASYNC_MODE, or sending it otherwise
+ */
+static void LCD_output(uint8 value, uint8 rs_value);
+
+#if(LCD_DATA_BITS_MODE == 4)
+/*
+ * Function responsible for sending the 4-bits on DB4 --> DB7 with one Enable pulse
+ */
+static void LCD_writeNibble(uint8 nibble);
+#endif
+
+/*
+ * Function responsible for waiting until the LCD finishes the last instruction,
+ * by reading the busy flag or by waiting the instruction execution time
+ */
+static void LCD_waitReady(boolean long_instruction);
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Initialize the LCD:
+ * 1. Setup the LCD pins directions by use the GPIO driver.
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ */
+void LCD_init(void)
+{
+	/* Configure the direction for RS and E pins as output pins */
+	GPIO_SETUP_PIN_DIRECTION(LCD_RS_PORT_ID,LCD_RS_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_E_PORT_ID,LCD_E_PIN_ID,PIN_OUTPUT);
+
+#ifdef LCD_RW_PIN_ENABLED
+	/* Configure the direction for R/W pin as output pin, it is kept in Write Mode R/W=0 */
+	GPIO_SETUP_PIN_DIRECTION(LCD_RW_PORT_ID,LCD_RW_PIN_ID,PIN_OUTPUT);
+	GPIO_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW);
+#endif
+
+	_delay_ms(20);		/* LCD Power ON delay always > 15ms */
+
+#if(LCD_DATA_BITS_MODE == 4)
+	/* Configure 4 pins in the data port as output pins */
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_OUTPUT);
+
+	/* Send for 4 bit initialization of LCD (LCD_TWO_LINES_FOUR_BITS_MODE_INIT1 then INIT2),
+	 * the LCD is still in 8-bits mode so each nibble is a separate instruction
+	 * and the busy flag can't be read yet */
+	GPIO_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW); /* Instruction Mode RS=0 */
+	LCD_writeNibble(0x03);
+	_delay_ms(5);
+	LCD_writeNibble(0x03);
+	_delay_us(150);
+	LCD_writeNibble(0x03);
+	_delay_us(LCD_EXECUTION_TIME_US);
+	LCD_writeNibble(0x02);
+	_delay_us(LCD_EXECUTION_TIME_US);
+
+	/* use 2-lines LCD + 4-bits Data Mode + 5*7 dot display Mode */
+	LCD_write(LCD_TWO_LINES_FOUR_BITS_MODE,LOGIC_LOW);
+
+#elif(LCD_DATA_BITS_MODE == 8)
+	/* Configure the data port as output port */
+	GPIO_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_OUTPUT);
+
+	/* use 2-lines LCD + 8-bits Data Mode + 5*7 dot display Mode */
+	LCD_write(LCD_TWO_LINES_EIGHT_BITS_MODE,LOGIC_LOW);
+
+#endif
+
+	LCD_write(LCD_CURSOR_OFF,LOGIC_LOW); /* cursor off */
+	LCD_write(LCD_CLEAR_COMMAND,LOGIC_LOW); /* clear LCD at the beginning */
+
+#ifdef LCD_SHADOW_MODE
+	{
+		uint8 row,col;
+		for(row = 0; row < LCD_NUM_ROWS; row++)
+		{
+			for(col = 0; col < LCD_NUM_COLS; col++)
+			{
+				g_shadow[row][col] = ' ';
+				g_screen[row][col] = ' ';
+			}
+		}
+		g_cursorRow = 0;
+		g_cursorCol = 0;
+	}
+#endif
+}
+
+/*
+ * Description :
+ * Send the required command to the screen
+ */
+void LCD_sendCommand(uint8 command)
+{
+	LCD_output(command,LOGIC_LOW); /* Instruction Mode RS=0 */
+}
+
+/*
+ * Description :
+ * Display the required character on the screen
+ */
+void LCD_displayCharacter(uint8 data)
+{
+#ifdef LCD_SHADOW_MODE
+	/* Characters out of the screen are dropped */
+	if((g_cursorRow < LCD_NUM_ROWS) && (g_cursorCol < LCD_NUM_COLS))
+	{
+		g_shadow[g_cursorRow][g_cursorCol] = data;
+		g_cursorCol++;
+	}
+#else
+	LCD_output(data,LOGIC_HIGH); /* Data Mode RS=1 */
+#endif
+}
+
+/*
+ * Description :
+ * Display the required string on the screen
+ */
+void LCD_displayString(const char *Str)
+{
+	uint8 i = 0;
+	while(Str[i] != '\0')
+	{
+		LCD_displayCharacter(Str[i]);
+		i++;
+	}
+	/***************** Another Method ***********************
+	while((*Str) != '\0')
+	{
+		LCD_displayCharacter(*Str);
+		Str++;
+	}		
+	*********************************************************/
+}
+
+/*
+ * Description :
+ * Display the required string from the program memory (PROGMEM) on the screen
+ */
+void LCD_displayString_P(const char *Str)
+{
+	uint8 data;
+	/* Each character is read from the flash, the string is never copied to the RAM */
+	while((data = pgm_read_byte(Str)) != '\0')
+	{
+		LCD_displayCharacter(data);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Move the cursor to a specified row and column index on the screen
+ */
+void LCD_moveCursor(uint8 row,uint8 col)
+{
+#ifdef LCD_SHADOW_MODE
+	g_cursorRow = row;
+	g_cursorCol = col;
+#else
+	uint8 lcd_memory_address;
+	
+	/* Calculate the required address in the LCD DDRAM */
+	switch(row)
+	{
+		case 0:
+			lcd_memory_address=col;
+				break;
+		case 1:
+			lcd_memory_address=col+0x40;
+				break;
+		case 2:
+			lcd_memory_address=col+0x10;
+				break;
+		case 3:
+			lcd_memory_address=col+0x50;
+				break;
+	}					
+	/* Move the LCD cursor to this specific address */
+	LCD_sendCommand(lcd_memory_address | LCD_SET_CURSOR_LOCATION);
+#endif
+}
+
+/*
+ * Description :
+ * Display the required string in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayString(Str); /* display the string */
+}
+
+/*
+ * Description :
+ * Display the required string from the program memory (PROGMEM) in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str)
+{
+	LCD_moveCursor(row,col); /* go to to the required LCD position */
+	LCD_displayString_P(Str); /* display the string */
+}
+
+/*
+ * Description :
+ * Display the required decimal value on the screen
+ */
+void LCD_intgerToString(int data)
+{
+   char buff[16]; /* String to hold the ascii result */
+   itoa(data,buff,10); /* Use itoa C function to convert the data to its corresponding ASCII value, 10 for decimal */
+   LCD_displayString(buff); /* Display the string */
+}
+
+/*
+ * Description :
+ * Send the clear screen command
+ */
+void LCD_clearScreen(void)
+{
+#ifdef LCD_SHADOW_MODE
+	uint8 row,col;
+
+	/* Only the characters that are not spaces on the screen will be sent by LCD_flush */
+	for(row = 0; row < LCD_NUM_ROWS; row++)
+	{
+		for(col = 0; col < LCD_NUM_COLS; col++)
+		{
+			g_shadow[row][col] = ' ';
+		}
+	}
+	g_cursorRow = 0;
+	g_cursorCol = 0;
+#else
+	LCD_sendCommand(LCD_CLEAR_COMMAND); /* Send clear display command */
+#endif
+}
+
+/*
+ * Description :
+ * Send the characters changed since the last flush to the screen
+ */
+void LCD_flush(void)
+{
+#ifdef LCD_SHADOW_MODE
+	uint8 row,col;
+	boolean in_place; /* TRUE when the LCD address counter is on this character */
+
+	for(row = 0; row < LCD_NUM_ROWS; row++)
+	{
+		in_place = FALSE;
+		for(col = 0; col < LCD_NUM_COLS; col++)
+		{
+			if(g_shadow[row][col] == g_screen[row][col])
+			{
+				/* Sending one unchanged character between two changed ones costs the same as a cursor move,
+				 * so the run is kept to save the cursor move */
+				if(in_place && (col + 1 < LCD_NUM_COLS) && (g_shadow[row][col+1] != g_screen[row][col+1]))
+				{
+					LCD_output(g_shadow[row][col],LOGIC_HIGH);
+				}
+				else
+				{
+					in_place = FALSE;
+				}
+				continue;
+			}
+
+			if(!in_place)
+			{
+				LCD_sendCommand((pgm_read_byte(&g_rowAddress[row]) + col) | LCD_SET_CURSOR_LOCATION);
+				in_place = TRUE;
+			}
+			LCD_output(g_shadow[row][col],LOGIC_HIGH); /* Data Mode RS=1 */
+			g_screen[row][col] = g_shadow[row][col];
+		}
+	}
+#endif
+}
+
+/*
+ * Description :
+ * Send the next queued command or character to the LCD
+ */
+void LCD_task(void)
+{
+#ifdef LCD_ASYNC_MODE
+	uint16 entry;
+
+	/* The LCD is still doing the last long instruction */
+	if(g_waitTicks != 0)
+	{
+		g_waitTicks--;
+		return;
+	}
+
+	if(g_queueHead == g_queueTail)
+	{
+		return;
+	}
+	entry = g_queue[g_queueTail];
+	g_queueTail = (uint8)((g_queueTail + 1) & (LCD_QUEUE_SIZE - 1));
+
+	/* The next call is after LCD_TASK_PERIOD_US so the LCD finishes the short instructions by then */
+	LCD_writeBus((uint8)entry,(uint8)(entry >> 8));
+	if(LCD_IS_LONG_INSTRUCTION((uint8)entry,(uint8)(entry >> 8)))
+	{
+		g_waitTicks = LCD_LONG_INSTRUCTION_TICKS;
+	}
+#endif
+}
+
+/*
+ * Description :
+ * Return TRUE when all the queued commands and characters are done by the LCD
+ */
+boolean LCD_isIdle(void)
+{
+#ifdef LCD_ASYNC_MODE
+	return ((g_queueHead == g_queueTail) && (g_waitTicks == 0));
+#else
+	return TRUE;
+#endif
+}
+
+/*
+ * Description :
+ * Queue a command or a character in LCD_ASYNC_MODE, or send it otherwise
+ */
+static void LCD_output(uint8 value, uint8 rs_value)
+{
+#ifdef LCD_ASYNC_MODE
+	uint8 next_head = (uint8)((g_queueHead + 1) & (LCD_QUEUE_SIZE - 1));
+
+	/* It only waits if the queue is full */
+	while(next_head == g_queueTail);
+
+	g_queue[g_queueHead] = ((uint16)rs_value << 8) | value;
+	g_queueHead = next_head;
+#else
+	LCD_write(value,rs_value);
+#endif
+}
+
+/*
+ * Description :
+ * Send a command or a character to the LCD then wait until it is done
+ */
+static void LCD_write(uint8 value, uint8 rs_value)
+{
+	LCD_writeBus(value,rs_value);
+	LCD_waitReady(LCD_IS_LONG_INSTRUCTION(value,rs_value));
+}
+
+/*
+ * Description :
+ * Send a command or a character to the LCD without waiting
+ */
+static void LCD_writeBus(uint8 value, uint8 rs_value)
+{
+	GPIO_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,rs_value); /* Tas = 50ns is less than one GPIO call */
+
+#if(LCD_DATA_BITS_MODE == 4)
+	LCD_writeNibble(value >> 4);
+	LCD_writeNibble(value);
+
+#elif(LCD_DATA_BITS_MODE == 8)
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+	GPIO_WRITE_PORT(LCD_DATA_PORT_ID,value); /* out the required value to the data bus D0 --> D7 */
+	_delay_us(1); /* delay for processing Tpw = 230ns */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 10ns & Tcycle = 500ns */
+#endif
+}
+
+#if(LCD_DATA_BITS_MODE == 4)
+/*
+ * Description :
+ * Send the 4-bits on DB4 --> DB7 with one Enable pulse
+ */
+static void LCD_writeNibble(uint8 nibble)
+{
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,GET_BIT(nibble,0));
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,GET_BIT(nibble,1));
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,GET_BIT(nibble,2));
+	GPIO_WRITE_PIN(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,GET_BIT(nibble,3));
+
+	_delay_us(1); /* delay for processing Tpw = 230ns */
+	GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+	_delay_us(1); /* delay for processing Th = 10ns & Tcycle = 500ns */
+}
+#endif
+
+/*
+ * Description :
+ * Wait until the LCD finishes the last instruction
+ */
+static void LCD_waitReady(boolean long_instruction)
+{
+#ifdef LCD_RW_PIN_ENABLED
+	uint8 busy;
+	uint16 polls = 0;
+
+	(void)long_instruction; /* the busy flag tells when any instruction is done */
+
+	/* Release the data bus to the LCD */
+#if(LCD_DATA_BITS_MODE == 4)
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_INPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_INPUT);
+#elif(LCD_DATA_BITS_MODE == 8)
+	GPIO_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_INPUT);
+#endif
+
+	GPIO_WRITE_PIN(LCD_RS_PORT_ID,LCD_RS_PIN_ID,LOGIC_LOW);  /* Instruction Mode RS=0 */
+	GPIO_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_HIGH); /* Read Mode R/W=1 */
+
+	do
+	{
+		GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH); /* Enable LCD E=1 */
+		_delay_us(1); /* delay for processing Tddr = 160ns */
+		busy = GPIO_READ_PIN(LCD_DATA_PORT_ID,LCD_BUSY_FLAG_PIN_ID);
+		GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW); /* Disable LCD E=0 */
+		_delay_us(1);
+
+#if(LCD_DATA_BITS_MODE == 4)
+		/* The second nibble (address counter) is not needed but it must be read */
+		GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_HIGH);
+		_delay_us(1);
+		GPIO_WRITE_PIN(LCD_E_PORT_ID,LCD_E_PIN_ID,LOGIC_LOW);
+		_delay_us(1);
+#endif
+		polls++;
+	}while((busy == LOGIC_HIGH) && (polls < LCD_BUSY_MAX_POLLS));
+
+	GPIO_WRITE_PIN(LCD_RW_PORT_ID,LCD_RW_PIN_ID,LOGIC_LOW);  /* Write Mode R/W=0 */
+
+	/* Take the data bus back */
+#if(LCD_DATA_BITS_MODE == 4)
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB4_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB5_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB6_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(LCD_DATA_PORT_ID,LCD_DB7_PIN_ID,PIN_OUTPUT);
+#elif(LCD_DATA_BITS_MODE == 8)
+	GPIO_SETUP_PORT_DIRECTION(LCD_DATA_PORT_ID,PORT_OUTPUT);
+#endif
+
+#else
+	if(long_instruction)
+	{
+		_delay_us(LCD_LONG_EXECUTION_TIME_US);
+	}
+	else
+	{
+		_delay_us(LCD_EXECUTION_TIME_US);
+	}
+#endif
+}
@@ -0,0 +1,205 @@
+ /******************************************************************************
+ *
+ * Module: LCD
+ *
+ * File Name: lcd.h
+ *
+ * Description: Header file for the LCD driver
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef LCD_H_
+#define LCD_H_
+
+#include "../../MCAL/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+
+/* LCD Data bits mode configuration, its value should be 4 or 8*/
+#define LCD_DATA_BITS_MODE 8
+
+#if((LCD_DATA_BITS_MODE != 4) && (LCD_DATA_BITS_MODE != 8))
+
+#error "Number of Data bits should be equal to 4 or 8"
+
+#endif
+
+/* to adjust the LCD output mode, define LCD_SHADOW_MODE to write in a RAM copy of the screen
+ * and send only the changed characters by LCD_flush, otherwise every call is sent to the LCD directly */
+#define LCD_SHADOW_MODE
+
+/* define LCD_ASYNC_MODE to queue the commands and characters without waiting, LCD_task sends them one by one
+ * from a timer ISR, otherwise every command or character is sent before the call returns */
+#define LCD_ASYNC_MODE
+
+#ifdef LCD_ASYNC_MODE
+
+/* LCD_task should be called every LCD_TASK_PERIOD_US, it should be longer than the execution time of an instruction */
+#define LCD_TASK_PERIOD_US 1000
+
+/* Size of the output queue, it should be a power of 2 and not more than 256 */
+#define LCD_QUEUE_SIZE 64
+
+#if((LCD_QUEUE_SIZE & (LCD_QUEUE_SIZE - 1)) || (LCD_QUEUE_SIZE > 256))
+#error "LCD_QUEUE_SIZE should be a power of 2 and not more than 256"
+#endif
+
+#endif
+
+/* LCD size */
+#define LCD_NUM_ROWS 2
+#define LCD_NUM_COLS 16
+
+/* LCD HW Ports and Pins Id */
+#define LCD_RS_PORT_ID                 PORTB_ID
+#define LCD_RS_PIN_ID                  PIN3_ID
+
+#define LCD_E_PORT_ID                  PORTB_ID
+#define LCD_E_PIN_ID                   PIN2_ID
+
+#define LCD_DATA_PORT_ID               PORTA_ID
+
+#if (LCD_DATA_BITS_MODE == 4)
+
+#define LCD_DB4_PIN_ID                 PIN3_ID
+#define LCD_DB5_PIN_ID                 PIN4_ID
+#define LCD_DB6_PIN_ID                 PIN5_ID
+#define LCD_DB7_PIN_ID                 PIN6_ID
+
+/* The busy flag is read on DB7 */
+#define LCD_BUSY_FLAG_PIN_ID           LCD_DB7_PIN_ID
+
+#elif (LCD_DATA_BITS_MODE == 8)
+
+#define LCD_BUSY_FLAG_PIN_ID           PIN7_ID
+
+#endif
+
+/* Define LCD_RW_PIN_ENABLED when the LCD R/W pin is connected to the MCU, then the busy flag is read
+ * to know when the LCD finished each instruction, otherwise R/W is tied to the ground and the
+ * driver waits the execution time of each instruction */
+/* #define LCD_RW_PIN_ENABLED */
+
+#ifdef LCD_RW_PIN_ENABLED
+
+#define LCD_RW_PORT_ID                 PORTB_ID
+#define LCD_RW_PIN_ID                  PIN1_ID
+
+/* The busy flag is read at most this number of times (more than 2 ms) before giving up */
+#define LCD_BUSY_MAX_POLLS             1000
+
+#endif
+
+/* Execution times of the instructions, used when the busy flag is not read */
+#define LCD_EXECUTION_TIME_US          50     /* 37 us for most of the instructions */
+#define LCD_LONG_EXECUTION_TIME_US     2000   /* 1.52 ms for the clear and return home instructions */
+
+#if(defined(LCD_ASYNC_MODE) && (LCD_TASK_PERIOD_US < LCD_EXECUTION_TIME_US))
+#error "LCD_TASK_PERIOD_US should be longer than LCD_EXECUTION_TIME_US"
+#endif
+
+/* LCD Commands */
+#define LCD_CLEAR_COMMAND                    0x01
+#define LCD_GO_TO_HOME                       0x02
+#define LCD_TWO_LINES_EIGHT_BITS_MODE        0x38
+#define LCD_TWO_LINES_FOUR_BITS_MODE         0x28
+#define LCD_TWO_LINES_FOUR_BITS_MODE_INIT1   0x33
+#define LCD_TWO_LINES_FOUR_BITS_MODE_INIT2   0x32
+#define LCD_CURSOR_OFF                       0x0C
+#define LCD_CURSOR_ON                        0x0E
+#define LCD_SET_CURSOR_LOCATION              0x80
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Initialize the LCD:
+ * 1. Setup the LCD pins directions by use the GPIO driver.
+ * 2. Setup the LCD Data Mode 4-bits or 8-bits.
+ * It always waits until the LCD is ready, even in LCD_ASYNC_MODE.
+ */
+void LCD_init(void);
+
+/*
+ * Description :
+ * Send the required command to the screen,
+ * in LCD_SHADOW_MODE the screen is changed by the other functions only so the RAM copy stays right.
+ */
+void LCD_sendCommand(uint8 command);
+
+/*
+ * Description :
+ * Display the required character on the screen
+ */
+void LCD_displayCharacter(uint8 data);
+
+/*
+ * Description :
+ * Display the required string on the screen
+ */
+void LCD_displayString(const char *Str);
+
+/*
+ * Description :
+ * Display the required string from the program memory (PROGMEM) on the screen
+ */
+void LCD_displayString_P(const char *Str);
+
+/*
+ * Description :
+ * Move the cursor to a specified row and column index on the screen
+ */
+void LCD_moveCursor(uint8 row,uint8 col);
+
+/*
+ * Description :
+ * Display the required string in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Display the required string from the program memory (PROGMEM) in a specified row and column index on the screen
+ */
+void LCD_displayStringRowColumn_P(uint8 row,uint8 col,const char *Str);
+
+/*
+ * Description :
+ * Display the required decimal value on the screen
+ */
+void LCD_intgerToString(int data);
+
+/*
+ * Description :
+ * Send the clear screen command
+ */
+void LCD_clearScreen(void);
+
+/*
+ * Description :
+ * In LCD_SHADOW_MODE send the characters changed since the last flush to the screen,
+ * a cursor move is sent only where the changed characters are not next to each other.
+ * Otherwise it does nothing.
+ */
+void LCD_flush(void);
+
+/*
+ * Description :
+ * In LCD_ASYNC_MODE send the next queued command or character to the LCD,
+ * it should be called every LCD_TASK_PERIOD_US from a timer ISR. Otherwise it does nothing.
+ */
+void LCD_task(void);
+
+/*
+ * Description :
+ * Return TRUE when all the queued commands and characters are done by the LCD.
+ */
+boolean LCD_isIdle(void);
+
+#endif /* LCD_H_ */
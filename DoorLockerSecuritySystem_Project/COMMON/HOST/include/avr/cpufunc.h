@@ -0,0 +1,18 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: cpufunc.h
+ *
+ * Description: Host replacement of <avr/cpufunc.h>
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_CPUFUNC_H_
+#define HOST_AVR_CPUFUNC_H_
+
+#define _NOP()  do { } while(0)
+
+#endif /* HOST_AVR_CPUFUNC_H_ */
@@ -0,0 +1,25 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: interrupt.h
+ *
+ * Description: Host replacement of <avr/interrupt.h>, an ISR is a normal function
+ *              with the name of its vector so the host can call it
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_INTERRUPT_H_
+#define HOST_AVR_INTERRUPT_H_
+
+#include <avr/io.h>
+
+#define ISR(vector)  void vector(void); void vector(void)
+
+/* The I-bit of SREG */
+#define sei()        (SREG |= 0x80)
+#define cli()        (SREG &= 0x7F)
+
+#endif /* HOST_AVR_INTERRUPT_H_ */
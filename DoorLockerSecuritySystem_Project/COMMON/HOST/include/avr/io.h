@@ -0,0 +1,228 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: io.h
+ *
+ * Description: Host replacement of <avr/io.h> for the ATmega32, the IO registers
+ *              are simulated by sim_core.c and the peripheral models
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_IO_H_
+#define HOST_AVR_IO_H_
+
+#include <stdint.h>
+
+/*******************************************************************************
+ *                                IO Registers                                 *
+ *******************************************************************************/
+/*
+ * Every register access goes through SIM_access() so the simulated peripherals see
+ * the reads and the writes. The previous access is committed on the next call: the
+ * models compare the register with its value before the access, UDR, TWCR and TIFR
+ * are 16-bit with a marker in the high byte because writing them the same value is
+ * still an action (send a byte, clear a flag).
+ */
+typedef enum
+{
+	SIM_PORTA,SIM_DDRA,SIM_PINA,SIM_PORTB,SIM_DDRB,SIM_PINB,
+	SIM_PORTC,SIM_DDRC,SIM_PINC,SIM_PORTD,SIM_DDRD,SIM_PIND,
+	SIM_MCUCR,SIM_GICR,
+	SIM_UDR,SIM_UCSRA,SIM_UCSRB,SIM_UCSRC,SIM_UBRRH,SIM_UBRRL,
+	SIM_TCCR0,SIM_TCNT0,SIM_OCR0,
+	SIM_TCCR1A,SIM_TCCR1B,SIM_TCNT1,SIM_OCR1A,SIM_OCR1B,SIM_ICR1,SIM_TIMSK,SIM_TIFR,
+	SIM_TWBR,SIM_TWSR,SIM_TWAR,SIM_TWDR,SIM_TWCR,
+	SIM_REG_COUNT,SIM_REG_NONE = SIM_REG_COUNT
+}SIM_Register;
+
+volatile void *SIM_access(SIM_Register reg);
+
+#define SIM_REG8(reg)   (*(volatile uint8_t *)SIM_access(reg))
+#define SIM_REG16(reg)  (*(volatile uint16_t *)SIM_access(reg))
+
+/* GPIO */
+#define PORTA   SIM_REG8(SIM_PORTA)
+#define DDRA    SIM_REG8(SIM_DDRA)
+#define PINA    SIM_REG8(SIM_PINA)
+#define PORTB   SIM_REG8(SIM_PORTB)
+#define DDRB    SIM_REG8(SIM_DDRB)
+#define PINB    SIM_REG8(SIM_PINB)
+#define PORTC   SIM_REG8(SIM_PORTC)
+#define DDRC    SIM_REG8(SIM_DDRC)
+#define PINC    SIM_REG8(SIM_PINC)
+#define PORTD   SIM_REG8(SIM_PORTD)
+#define DDRD    SIM_REG8(SIM_DDRD)
+#define PIND    SIM_REG8(SIM_PIND)
+
+/* CPU, SREG is a plain variable: only the I-bit is used and the interrupts are taken between accesses */
+extern volatile uint8_t SREG;
+#define MCUCR   SIM_REG8(SIM_MCUCR)
+#define GICR    SIM_REG8(SIM_GICR)
+
+/* UART */
+#define UDR     SIM_REG16(SIM_UDR)
+#define UCSRA   SIM_REG8(SIM_UCSRA)
+#define UCSRB   SIM_REG8(SIM_UCSRB)
+#define UCSRC   SIM_REG8(SIM_UCSRC)
+#define UBRRH   SIM_REG8(SIM_UBRRH)
+#define UBRRL   SIM_REG8(SIM_UBRRL)
+
+/* Timers */
+#define TCCR0   SIM_REG8(SIM_TCCR0)
+#define TCNT0   SIM_REG8(SIM_TCNT0)
+#define OCR0    SIM_REG8(SIM_OCR0)
+#define TCCR1A  SIM_REG8(SIM_TCCR1A)
+#define TCCR1B  SIM_REG8(SIM_TCCR1B)
+#define TCNT1   SIM_REG16(SIM_TCNT1)
+#define OCR1A   SIM_REG16(SIM_OCR1A)
+#define OCR1B   SIM_REG16(SIM_OCR1B)
+#define ICR1    SIM_REG16(SIM_ICR1)
+#define TIMSK   SIM_REG8(SIM_TIMSK)
+#define TIFR    SIM_REG16(SIM_TIFR)
+
+/* TWI */
+#define TWBR    SIM_REG8(SIM_TWBR)
+#define TWSR    SIM_REG8(SIM_TWSR)
+#define TWAR    SIM_REG8(SIM_TWAR)
+#define TWDR    SIM_REG8(SIM_TWDR)
+#define TWCR    SIM_REG16(SIM_TWCR)
+
+/*******************************************************************************
+ *                                 Bits Numbers                                *
+ *******************************************************************************/
+/* UCSRA */
+#define RXC     7
+#define TXC     6
+#define UDRE    5
+#define FE      4
+#define DOR     3
+#define PE      2
+#define U2X     1
+#define MPCM    0
+
+/* UCSRB */
+#define RXCIE   7
+#define TXCIE   6
+#define UDRIE   5
+#define RXEN    4
+#define TXEN    3
+#define UCSZ2   2
+#define RXB8    1
+#define TXB8    0
+
+/* UCSRC */
+#define URSEL   7
+#define UMSEL   6
+#define UPM1    5
+#define UPM0    4
+#define USBS    3
+#define UCSZ1   2
+#define UCSZ0   1
+#define UCPOL   0
+
+/* TCCR0 */
+#define FOC0    7
+#define WGM00   6
+#define COM01   5
+#define COM00   4
+#define WGM01   3
+#define CS02    2
+#define CS01    1
+#define CS00    0
+
+/* TCCR1A */
+#define COM1A1  7
+#define COM1A0  6
+#define COM1B1  5
+#define COM1B0  4
+#define FOC1A   3
+#define FOC1B   2
+#define WGM11   1
+#define WGM10   0
+
+/* TCCR1B */
+#define ICNC1   7
+#define ICES1   6
+#define WGM13   4
+#define WGM12   3
+#define CS12    2
+#define CS11    1
+#define CS10    0
+
+/* TIMSK */
+#define OCIE2   7
+#define TOIE2   6
+#define TICIE1  5
+#define OCIE1A  4
+#define OCIE1B  3
+#define TOIE1   2
+#define OCIE0   1
+#define TOIE0   0
+
+/* TIFR */
+#define OCF2    7
+#define TOV2    6
+#define ICF1    5
+#define OCF1A   4
+#define OCF1B   3
+#define TOV1    2
+#define OCF0    1
+#define TOV0    0
+
+/* TWCR */
+#define TWINT   7
+#define TWEA    6
+#define TWSTA   5
+#define TWSTO   4
+#define TWWC    3
+#define TWEN    2
+#define TWIE    0
+
+/* TWSR */
+#define TWPS1   1
+#define TWPS0   0
+
+/* MCUCR */
+#define SE      7
+#define SM2     6
+#define SM1     5
+#define SM0     4
+
+/* Port pins */
+#define PA0 0
+#define PA1 1
+#define PA2 2
+#define PA3 3
+#define PA4 4
+#define PA5 5
+#define PA6 6
+#define PA7 7
+#define PB0 0
+#define PB1 1
+#define PB2 2
+#define PB3 3
+#define PB4 4
+#define PB5 5
+#define PB6 6
+#define PB7 7
+#define PC0 0
+#define PC1 1
+#define PC2 2
+#define PC3 3
+#define PC4 4
+#define PC5 5
+#define PC6 6
+#define PC7 7
+#define PD0 0
+#define PD1 1
+#define PD2 2
+#define PD3 3
+#define PD4 4
+#define PD5 5
+#define PD6 6
+#define PD7 7
+
+#endif /* HOST_AVR_IO_H_ */
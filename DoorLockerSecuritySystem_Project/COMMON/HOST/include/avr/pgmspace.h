@@ -0,0 +1,26 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: pgmspace.h
+ *
+ * Description: Host replacement of <avr/pgmspace.h>, the host has one address space
+ *              so the program memory is read like the RAM
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef HOST_AVR_PGMSPACE_H_
+#define HOST_AVR_PGMSPACE_H_
+
+#include <stdint.h>
+#include <string.h>
+
+#define PROGMEM
+#define PSTR(str)            (str)
+#define pgm_read_byte(addr)  (*(const uint8_t *)(addr))
+#define pgm_read_word(addr)  (*(const uint16_t *)(addr))
+#define memcpy_P             memcpy
+
+#endif /* HOST_AVR_PGMSPACE_H_ */
@@ -0,0 +1,19 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: delay.h
+ *
+ * Description: Host replacement of <util/delay.h>, the delays are functions in host_io.c
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef HOST_UTIL_DELAY_H_
+#define HOST_UTIL_DELAY_H_
+
+void _delay_ms(double ms);
+void _delay_us(double us);
+
+#endif /* HOST_UTIL_DELAY_H_ */
@@ -0,0 +1,88 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim.h
+ *
+ * Description: Interface between the simulation core and the peripheral models of the host build
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef HOST_SIM_H_
+#define HOST_SIM_H_
+
+#include <stdint.h>
+#include <avr/io.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* The simulated time is counted in CPU cycles */
+#define SIM_CYCLES_PER_US   (F_CPU / 1000000UL)
+#define SIM_CYCLES_PER_MS   (F_CPU / 1000UL)
+#define SIM_NEVER           UINT64_MAX
+
+/* Marker of UDR, TWCR and TIFR: set when the register is prepared, cleared by a write */
+#define SIM_MARKER          0x100
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef uint64_t SIM_Cycles;
+
+typedef void (*SIM_Vector)(void);
+
+/*******************************************************************************
+ *                              Shared Variables                               *
+ *******************************************************************************/
+/* Register storage, an 8-bit register uses the low byte of its entry */
+extern volatile uint16_t g_simRegisters[SIM_REG_COUNT];
+
+/* Time of the simulation, every model works at this time */
+extern SIM_Cycles g_simTime;
+
+/* "HMI" or "CONTROL", it selects the board models */
+extern const char *g_simName;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+/* Core */
+SIM_Cycles SIM_now(void);
+void SIM_log(const char *format, ...) __attribute__((format(printf, 1, 2)));
+
+/*
+ * Each model has:
+ *  - Init    : read its environment variables
+ *  - Prepare : give the value of a register before the code reads or writes it
+ *  - Commit  : act on the register after the access, old is the prepared value
+ *  - Update  : bring the model to the given time, return the time of its next event
+ *  - Pending : return the vector of its highest priority interrupt and clear the flag
+ *              that the hardware clears when the vector is executed
+ */
+void SIM_timer1Init(void);
+void SIM_timer1Prepare(SIM_Register reg);
+void SIM_timer1Commit(SIM_Register reg, uint16_t old);
+SIM_Cycles SIM_timer1Update(SIM_Cycles time);
+SIM_Vector SIM_timer1Pending(void);
+
+void SIM_uartInit(void);
+void SIM_uartPrepare(SIM_Register reg);
+void SIM_uartCommit(SIM_Register reg, uint16_t old);
+SIM_Cycles SIM_uartUpdate(SIM_Cycles time);
+SIM_Vector SIM_uartPending(void);
+
+void SIM_twiInit(void);
+void SIM_twiPrepare(SIM_Register reg);
+void SIM_twiCommit(SIM_Register reg, uint16_t old);
+SIM_Cycles SIM_twiUpdate(SIM_Cycles time);
+SIM_Vector SIM_twiPending(void);
+
+void SIM_boardInit(void);
+void SIM_boardPrepare(SIM_Register reg);
+void SIM_boardCommit(SIM_Register reg, uint16_t old);
+SIM_Cycles SIM_boardUpdate(SIM_Cycles time);
+
+#endif /* HOST_SIM_H_ */
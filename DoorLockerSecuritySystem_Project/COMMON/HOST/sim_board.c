@@ -0,0 +1,291 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim_board.c
+ *
+ * Description: Models of the boards for the host simulation: scripted keypad and
+ *              captured LCD of the HMI ECU, motor and buzzer of the control ECU
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include "sim.h"
+
+#include <stdlib.h>
+#include <string.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Wiring of the HMI board, the LCD is used in 8-bits mode */
+#define SIM_LCD_E_PIN          PB2
+#define SIM_LCD_RS_PIN         PB3
+#define SIM_KEYPAD_ROW_PIN     PB4   /* rows on PORTB 4..7 */
+#define SIM_KEYPAD_COL_PIN     PC4   /* columns on PORTC 4..7 */
+
+/* Wiring of the control board */
+#define SIM_MOTOR_IN1_PIN      PB0
+#define SIM_MOTOR_IN2_PIN      PB1
+#define SIM_BUZZER_PIN         PA0
+
+#define SIM_KEY_PRESS_TIME     (80 * SIM_CYCLES_PER_MS)
+#define SIM_KEY_RELEASE_TIME   (80 * SIM_CYCLES_PER_MS)
+#define SIM_KEY_SCRIPT_SIZE    256
+
+/* The screen is printed when the LCD did not change for this time */
+#define SIM_LCD_SETTLE_TIME    (2 * SIM_CYCLES_PER_MS)
+
+#define SIM_LCD_ROWS           2
+#define SIM_LCD_COLS           16
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef struct
+{
+	SIM_Cycles press;
+	SIM_Cycles release;
+	char key;
+	uint8_t button;   /* row * 4 + column */
+}SIM_KeyPress;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+/* Keys of each row of the 4x4 keypad, 'c' is the ON/C key */
+static const char g_keypadLayout[] = "741c" "8520" "963=" "%*-+";
+
+static uint8_t g_hmiBoard;
+static uint8_t g_controlBoard;
+
+/* Keypad script and the key being pressed */
+static SIM_KeyPress g_keyScript[SIM_KEY_SCRIPT_SIZE];
+static uint16_t g_keyCount;
+static uint16_t g_keyIndex;
+static uint8_t g_keyDown;
+
+/* LCD display data RAM of the two visible lines */
+static char g_lcdScreen[SIM_LCD_ROWS][SIM_LCD_COLS];
+static uint8_t g_lcdAddress;
+static uint8_t g_lcdDirty;
+static SIM_Cycles g_lcdChanged;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+static void SIM_keypadLoad(const char *script);
+static uint8_t SIM_keypadColumns(void);
+static void SIM_lcdLatch(uint8_t data, uint8_t rs);
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * SIM_NAME selects the board. The HMI keypad plays SIM_KEYPAD, see SIM_keypadLoad.
+ */
+void SIM_boardInit(void)
+{
+	g_hmiBoard = (strcmp(g_simName, "HMI") == 0);
+	g_controlBoard = (strcmp(g_simName, "CONTROL") == 0);
+
+	memset(g_lcdScreen, ' ', sizeof(g_lcdScreen));
+	if(g_hmiBoard && getenv("SIM_KEYPAD") != NULL)
+	{
+		SIM_keypadLoad(getenv("SIM_KEYPAD"));
+	}
+}
+
+/*
+ * Description :
+ * An input pin reads high (pull-up) unless the board pulls it low, an output pin reads its PORT bit.
+ */
+void SIM_boardPrepare(SIM_Register reg)
+{
+	uint8_t port, ddr, inputs = 0xFF;
+
+	if(reg != SIM_PINA && reg != SIM_PINB && reg != SIM_PINC && reg != SIM_PIND)
+	{
+		return;
+	}
+
+	port = (uint8_t)g_simRegisters[reg - 2];
+	ddr = (uint8_t)g_simRegisters[reg - 1];
+	if(reg == SIM_PINC && g_hmiBoard)
+	{
+		inputs &= (uint8_t)~(SIM_keypadColumns() << SIM_KEYPAD_COL_PIN);
+	}
+	g_simRegisters[reg] = (port & ddr) | (inputs & (uint8_t)~ddr);
+}
+
+void SIM_boardCommit(SIM_Register reg, uint16_t old)
+{
+	uint8_t value = (uint8_t)g_simRegisters[reg];
+	uint8_t changed = value ^ (uint8_t)old;
+
+	if(reg == SIM_PORTB && g_hmiBoard)
+	{
+		/* The LCD latches the bus on the falling edge of E */
+		if((changed & (1 << SIM_LCD_E_PIN)) && !(value & (1 << SIM_LCD_E_PIN)))
+		{
+			SIM_lcdLatch((uint8_t)g_simRegisters[SIM_PORTA], (value >> SIM_LCD_RS_PIN) & 1);
+		}
+	}
+	else if(reg == SIM_PORTB && g_controlBoard)
+	{
+		if(changed & ((1 << SIM_MOTOR_IN1_PIN) | (1 << SIM_MOTOR_IN2_PIN)))
+		{
+			SIM_log("MOTOR %s", (value & (1 << SIM_MOTOR_IN1_PIN)) ? "CW" :
+					(value & (1 << SIM_MOTOR_IN2_PIN)) ? "A_CW" : "STOP");
+		}
+	}
+	else if(reg == SIM_PORTA && g_controlBoard)
+	{
+		if(changed & (1 << SIM_BUZZER_PIN))
+		{
+			SIM_log("BUZZER %s", (value & (1 << SIM_BUZZER_PIN)) ? "ON" : "OFF");
+		}
+	}
+}
+
+/*
+ * Description :
+ * Press and release the keys of the script and print the LCD once it settled.
+ */
+SIM_Cycles SIM_boardUpdate(SIM_Cycles time)
+{
+	SIM_Cycles next = SIM_NEVER;
+
+	while(g_keyIndex < g_keyCount)
+	{
+		if(g_keyDown && g_keyScript[g_keyIndex].release <= time)
+		{
+			g_keyDown = 0;
+			SIM_log("KEY %c UP", g_keyScript[g_keyIndex].key);
+			g_keyIndex++;
+		}
+		else if(!g_keyDown && g_keyScript[g_keyIndex].press <= time)
+		{
+			g_keyDown = 1;
+			SIM_log("KEY %c DOWN", g_keyScript[g_keyIndex].key);
+		}
+		else
+		{
+			next = g_keyDown ? g_keyScript[g_keyIndex].release : g_keyScript[g_keyIndex].press;
+			break;
+		}
+	}
+
+	if(g_lcdDirty)
+	{
+		if(time >= g_lcdChanged + SIM_LCD_SETTLE_TIME)
+		{
+			g_lcdDirty = 0;
+			SIM_log("LCD |%.16s|%.16s|", g_lcdScreen[0], g_lcdScreen[1]);
+		}
+		else if(g_lcdChanged + SIM_LCD_SETTLE_TIME < next)
+		{
+			next = g_lcdChanged + SIM_LCD_SETTLE_TIME;
+		}
+	}
+	return next;
+}
+
+/*
+ * Description :
+ * Read the keypad script: each character is a key pressed for 80 ms then released
+ * for 80 ms, "@<ms>" waits before the next key and the spaces are ignored.
+ * Example: "@300 12345% 12345% @500 +12345%".
+ */
+static void SIM_keypadLoad(const char *script)
+{
+	SIM_Cycles time = 0;
+	const char *position;
+	char *end;
+
+	while(*script != '\0' && g_keyCount < SIM_KEY_SCRIPT_SIZE)
+	{
+		if(*script == '@')
+		{
+			time += strtoull(script + 1, &end, 10) * SIM_CYCLES_PER_MS;
+			script = end;
+			continue;
+		}
+		if((position = strchr(g_keypadLayout, *script)) != NULL)
+		{
+			g_keyScript[g_keyCount].press = time;
+			g_keyScript[g_keyCount].release = time + SIM_KEY_PRESS_TIME;
+			g_keyScript[g_keyCount].key = *script;
+			g_keyScript[g_keyCount].button = (uint8_t)(position - g_keypadLayout);
+			g_keyCount++;
+			time += SIM_KEY_PRESS_TIME + SIM_KEY_RELEASE_TIME;
+		}
+		script++;
+	}
+}
+
+/*
+ * Description :
+ * Return a bit = 1 for the column pulled low by the pressed key, its row must be an output driven low.
+ */
+static uint8_t SIM_keypadColumns(void)
+{
+	uint8_t row, row_pin;
+
+	if(!g_keyDown)
+	{
+		return 0;
+	}
+
+	row = g_keyScript[g_keyIndex].button / 4;
+	row_pin = (uint8_t)(1 << (SIM_KEYPAD_ROW_PIN + row));
+	if((g_simRegisters[SIM_DDRB] & row_pin) && !(g_simRegisters[SIM_PORTB] & row_pin))
+	{
+		return (uint8_t)(1 << (g_keyScript[g_keyIndex].button % 4));
+	}
+	return 0;
+}
+
+/*
+ * Description :
+ * HD44780 instructions that change what is shown: clear, return home, set DDRAM
+ * address and the characters. The other instructions only configure the LCD.
+ */
+static void SIM_lcdLatch(uint8_t data, uint8_t rs)
+{
+	uint8_t row = (g_lcdAddress >> 6) & 1;
+	uint8_t col = g_lcdAddress & 0x3F;
+
+	if(rs)
+	{
+		if(col < SIM_LCD_COLS)
+		{
+			g_lcdScreen[row][col] = ((data >= ' ') && (data < 0x7F)) ? (char)data : '?';
+		}
+		g_lcdAddress = (g_lcdAddress + 1) & 0x7F;
+	}
+	else if(data & 0x80)
+	{
+		g_lcdAddress = data & 0x7F;
+		return;
+	}
+	else if(data == 0x01)
+	{
+		memset(g_lcdScreen, ' ', sizeof(g_lcdScreen));
+		g_lcdAddress = 0;
+	}
+	else if((data & 0xFE) == 0x02)
+	{
+		g_lcdAddress = 0;
+		return;
+	}
+	else
+	{
+		return;
+	}
+	g_lcdDirty = 1;
+	g_lcdChanged = g_simTime;
+}
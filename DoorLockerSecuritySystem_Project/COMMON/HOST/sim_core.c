@@ -0,0 +1,383 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim_core.c
+ *
+ * Description: Simulated ATmega32 of the host build: register accesses, simulated
+ *              time, interrupts and the delay functions
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include "sim.h"
+
+#include <errno.h>
+#include <signal.h>
+#include <stdarg.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <unistd.h>
+#include <util/delay.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Real time period of the signal that runs the models while the code does not touch a register */
+#define SIM_TICK_PERIOD_US   100
+
+/* Shorter waits spin instead of sleeping */
+#define SIM_SPIN_LIMIT_NS    200000
+
+#define SIM_I_BIT            0x80
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+volatile uint16_t g_simRegisters[SIM_REG_COUNT];
+volatile uint8_t SREG;
+
+SIM_Cycles g_simTime;
+const char *g_simName = "ECU";
+
+/* The access that is not committed yet and the register value before it */
+static SIM_Register g_pending = SIM_REG_NONE;
+static uint16_t g_snapshot;
+
+/* Set while the core runs, the signal must not run the models in the middle of an access */
+static volatile sig_atomic_t g_busy;
+
+/* Number of vectors being executed */
+static uint8_t g_isrDepth;
+
+static uint64_t g_startNs;
+static uint64_t g_timeScale = 1;
+static SIM_Cycles g_endTime = SIM_NEVER;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+static uint64_t SIM_monotonicNs(void);
+static void SIM_prepare(SIM_Register reg);
+static void SIM_commit(void);
+static uint8_t SIM_dispatch(void);
+static void SIM_run(uint8_t dispatch);
+static void SIM_tick(int signal_number);
+static void SIM_wait(SIM_Cycles cycles);
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Set up the simulation before main: the models read their environment variables
+ * and the tick signal is started.
+ *  - SIM_NAME        : HMI or CONTROL, selects the board models
+ *  - SIM_TIME_SCALE  : simulated time runs this many times faster than the real time
+ *  - SIM_START_NS    : CLOCK_MONOTONIC origin shared by the two ECUs of one run
+ *  - SIM_DURATION_MS : the process exits at this simulated time
+ */
+__attribute__((constructor)) static void SIM_init(void)
+{
+	struct sigaction action;
+	struct itimerval period;
+	const char *value;
+
+	if((value = getenv("SIM_NAME")) != NULL)
+	{
+		g_simName = value;
+	}
+	if((value = getenv("SIM_TIME_SCALE")) != NULL && strtoull(value, NULL, 10) != 0)
+	{
+		g_timeScale = strtoull(value, NULL, 10);
+	}
+	if((value = getenv("SIM_DURATION_MS")) != NULL)
+	{
+		g_endTime = strtoull(value, NULL, 10) * SIM_CYCLES_PER_MS;
+	}
+	g_startNs = ((value = getenv("SIM_START_NS")) != NULL) ? strtoull(value, NULL, 10) : SIM_monotonicNs();
+	g_simTime = SIM_now();
+
+	SIM_timer1Init();
+	SIM_uartInit();
+	SIM_twiInit();
+	SIM_boardInit();
+
+	memset(&action, 0, sizeof(action));
+	action.sa_handler = SIM_tick;
+	action.sa_flags = SA_RESTART;
+	sigemptyset(&action.sa_mask);
+	sigaction(SIGALRM, &action, NULL);
+
+	period.it_interval.tv_sec = 0;
+	period.it_interval.tv_usec = SIM_TICK_PERIOD_US;
+	period.it_value = period.it_interval;
+	setitimer(ITIMER_REAL, &period, NULL);
+}
+
+/*
+ * Description :
+ * Return the simulated time, the real time since the start multiplied by the time scale.
+ */
+SIM_Cycles SIM_now(void)
+{
+	uint64_t elapsed = SIM_monotonicNs() - g_startNs;
+
+	return (elapsed * g_timeScale * SIM_CYCLES_PER_US) / 1000;
+}
+
+/*
+ * Description :
+ * Print one line to stdout with the simulated time and the ECU name. It is called
+ * from the signal too, so the line is written with one write() and no stdio buffer.
+ */
+void SIM_log(const char *format, ...)
+{
+	char line[256];
+	int length;
+	va_list args;
+
+	length = snprintf(line, sizeof(line), "[%8llu.%03llu ms] %-7s ",
+			(unsigned long long)(g_simTime / SIM_CYCLES_PER_MS),
+			(unsigned long long)((g_simTime % SIM_CYCLES_PER_MS) / SIM_CYCLES_PER_US), g_simName);
+	va_start(args, format);
+	length += vsnprintf(line + length, sizeof(line) - length - 1, format, args);
+	va_end(args);
+	if(length > (int)sizeof(line) - 2)
+	{
+		length = sizeof(line) - 2;
+	}
+	line[length++] = '\n';
+	(void)write(STDOUT_FILENO, line, length);
+}
+
+/*
+ * Description :
+ * Called by every register access of the drivers: commit the previous access, take the
+ * interrupts that became pending and return the storage of the register.
+ */
+volatile void *SIM_access(SIM_Register reg)
+{
+	if(g_isrDepth == 0)
+	{
+		g_busy = 1;
+		SIM_run(0);   /* the previous access takes effect at the current time */
+		SIM_commit();
+		SIM_run(1);   /* the code is between two instructions, the interrupts can be taken */
+		SIM_prepare(reg);
+		g_pending = reg;
+		g_busy = 0;
+	}
+	else
+	{
+		SIM_commit();
+		SIM_prepare(reg);
+		g_pending = reg;
+	}
+	return &g_simRegisters[reg];
+}
+
+void _delay_ms(double ms)
+{
+	SIM_wait((SIM_Cycles)(ms * SIM_CYCLES_PER_MS));
+}
+
+void _delay_us(double us)
+{
+	SIM_wait((SIM_Cycles)(us * SIM_CYCLES_PER_US));
+}
+
+static uint64_t SIM_monotonicNs(void)
+{
+	struct timespec now;
+
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	return ((uint64_t)now.tv_sec * 1000000000ULL) + (uint64_t)now.tv_nsec;
+}
+
+/*
+ * Description :
+ * Ask the model of the register for its value before the access and remember it.
+ */
+static void SIM_prepare(SIM_Register reg)
+{
+	if(reg >= SIM_UDR && reg <= SIM_UBRRL)
+	{
+		SIM_uartPrepare(reg);
+	}
+	else if(reg >= SIM_TCCR1A && reg <= SIM_TIFR)
+	{
+		SIM_timer1Prepare(reg);
+	}
+	else if(reg >= SIM_TWBR && reg <= SIM_TWCR)
+	{
+		SIM_twiPrepare(reg);
+	}
+	else
+	{
+		SIM_boardPrepare(reg);
+	}
+	g_snapshot = g_simRegisters[reg];
+}
+
+/*
+ * Description :
+ * Give the pending access to the model of its register.
+ */
+static void SIM_commit(void)
+{
+	SIM_Register reg = g_pending;
+
+	if(reg == SIM_REG_NONE)
+	{
+		return;
+	}
+	g_pending = SIM_REG_NONE;
+
+	if(reg >= SIM_UDR && reg <= SIM_UBRRL)
+	{
+		SIM_uartCommit(reg, g_snapshot);
+	}
+	else if(reg >= SIM_TCCR1A && reg <= SIM_TIFR)
+	{
+		SIM_timer1Commit(reg, g_snapshot);
+	}
+	else if(reg >= SIM_TWBR && reg <= SIM_TWCR)
+	{
+		SIM_twiCommit(reg, g_snapshot);
+	}
+	else
+	{
+		SIM_boardCommit(reg, g_snapshot);
+	}
+}
+
+/*
+ * Description :
+ * Execute the highest priority pending vector like the CPU does: the I-bit is cleared
+ * during the vector and set again by its return. Return 1 if a vector was executed.
+ */
+static uint8_t SIM_dispatch(void)
+{
+	SIM_Vector vector;
+
+	if((vector = SIM_timer1Pending()) == NULL &&
+	   (vector = SIM_uartPending()) == NULL &&
+	   (vector = SIM_twiPending()) == NULL)
+	{
+		return 0;
+	}
+
+	SREG &= (uint8_t)~SIM_I_BIT;
+	g_isrDepth++;
+	vector();
+	SIM_commit();
+	g_isrDepth--;
+	SREG |= SIM_I_BIT;
+	return 1;
+}
+
+/*
+ * Description :
+ * Bring all the models to the current time event by event, so a timer that expired
+ * several times while the host was busy still executes its vector each time.
+ */
+static void SIM_run(uint8_t dispatch)
+{
+	SIM_Cycles now = SIM_now();
+	SIM_Cycles next, event;
+
+	for(;;)
+	{
+		next = SIM_timer1Update(g_simTime);
+		if((event = SIM_uartUpdate(g_simTime)) < next)
+		{
+			next = event;
+		}
+		if((event = SIM_twiUpdate(g_simTime)) < next)
+		{
+			next = event;
+		}
+		if((event = SIM_boardUpdate(g_simTime)) < next)
+		{
+			next = event;
+		}
+
+		/* A vector can start a new event, look again at the same time after it */
+		if(dispatch && (SREG & SIM_I_BIT) && SIM_dispatch())
+		{
+			continue;
+		}
+		if(next > now)
+		{
+			break;
+		}
+		g_simTime = next;
+	}
+	if(now > g_simTime)
+	{
+		g_simTime = now;
+	}
+
+	if(g_simTime >= g_endTime)
+	{
+		SIM_log("end of simulation");
+		_exit(0);
+	}
+}
+
+/*
+ * Description :
+ * Tick signal: run the models while the code waits on RAM variables. The access that
+ * the code was doing is kept aside, the vectors commit their own accesses.
+ */
+static void SIM_tick(int signal_number)
+{
+	SIM_Register pending;
+	uint16_t snapshot;
+	int saved_errno = errno;
+
+	(void)signal_number;
+	if(g_busy)
+	{
+		return;   /* the core is already running, it takes the interrupts at its end */
+	}
+
+	g_busy = 1;
+	pending = g_pending;
+	snapshot = g_snapshot;
+	g_pending = SIM_REG_NONE;
+	SIM_run(1);
+	g_pending = pending;
+	g_snapshot = snapshot;
+	g_busy = 0;
+	errno = saved_errno;
+}
+
+/*
+ * Description :
+ * Busy wait of the delay functions, long waits sleep and let the tick signal run the models.
+ */
+static void SIM_wait(SIM_Cycles cycles)
+{
+	SIM_Cycles end = SIM_now() + cycles;
+	SIM_Cycles now;
+	uint64_t remaining_ns;
+	struct timespec sleep_time;
+
+	while((now = SIM_now()) < end)
+	{
+		remaining_ns = ((end - now) * 1000) / (SIM_CYCLES_PER_US * g_timeScale);
+		if(remaining_ns > SIM_SPIN_LIMIT_NS)
+		{
+			sleep_time.tv_sec = remaining_ns / 1000000000ULL;
+			sleep_time.tv_nsec = remaining_ns % 1000000000ULL;
+			nanosleep(&sleep_time, NULL);
+		}
+	}
+}
@@ -0,0 +1,150 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim_run.c
+ *
+ * Description: Launcher of the host simulation, it starts the two ECU images with a
+ *              socketpair as the UART line between them
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include <libgen.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/socket.h>
+#include <sys/wait.h>
+#include <time.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_DEFAULT_DURATION_MS  "10000"
+#define SIM_DEFAULT_TIME_SCALE   "1"
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+static pid_t SIM_start(const char *directory, const char *image, int uart_fd, int other_fd);
+static void SIM_usage(const char *program);
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * sim_run [-k keys] [-d duration_ms] [-t time_scale] [-e eeprom_file]
+ * The images are next to sim_run, both get the same time origin so their logs can be merged.
+ */
+int main(int argc, char *argv[])
+{
+	const char *duration = SIM_DEFAULT_DURATION_MS;
+	const char *scale = SIM_DEFAULT_TIME_SCALE;
+	char directory[4096], start[32];
+	int line[2], option, status, result = 0;
+	struct timespec now;
+	pid_t control, hmi, done;
+
+	while((option = getopt(argc, argv, "k:d:t:e:h")) != -1)
+	{
+		switch(option)
+		{
+		case 'k':
+			setenv("SIM_KEYPAD", optarg, 1);
+			break;
+		case 'd':
+			duration = optarg;
+			break;
+		case 't':
+			scale = optarg;
+			break;
+		case 'e':
+			setenv("SIM_EEPROM_FILE", optarg, 1);
+			break;
+		default:
+			SIM_usage(argv[0]);
+			return 2;
+		}
+	}
+
+	snprintf(directory, sizeof(directory), "%s", argv[0]);
+	snprintf(directory, sizeof(directory), "%s", dirname(directory));
+	clock_gettime(CLOCK_MONOTONIC, &now);
+	snprintf(start, sizeof(start), "%llu", (unsigned long long)now.tv_sec * 1000000000ULL + (unsigned long long)now.tv_nsec);
+	setenv("SIM_START_NS", start, 1);
+	setenv("SIM_DURATION_MS", duration, 1);
+	setenv("SIM_TIME_SCALE", scale, 1);
+
+	if(socketpair(AF_UNIX, SOCK_STREAM, 0, line) != 0)
+	{
+		perror("socketpair");
+		return 1;
+	}
+	control = SIM_start(directory, "CONTROL", line[0], line[1]);
+	hmi = SIM_start(directory, "HMI", line[1], line[0]);
+	close(line[0]);
+	close(line[1]);
+
+	/* The run ends with the first ECU, the other one is stopped */
+	while((done = wait(&status)) > 0)
+	{
+		if(!WIFEXITED(status) || WEXITSTATUS(status) != 0)
+		{
+			fprintf(stderr, "sim_run: %s ECU failed\n", (done == control) ? "CONTROL" : "HMI");
+			result = 1;
+		}
+		kill((done == control) ? hmi : control, SIGTERM);
+		if(done == control)
+		{
+			control = -1;
+		}
+		else
+		{
+			hmi = -1;
+		}
+		if(control == -1 && hmi == -1)
+		{
+			break;
+		}
+	}
+	return result;
+}
+
+/*
+ * Description :
+ * Start one ECU image with its end of the line, the other end is closed in the child.
+ */
+static pid_t SIM_start(const char *directory, const char *image, int uart_fd, int other_fd)
+{
+	char path[4200], fd[16];
+	pid_t pid = fork();
+
+	if(pid == 0)
+	{
+		close(other_fd);
+		snprintf(path, sizeof(path), "%s/%s_ECU", directory, image);
+		snprintf(fd, sizeof(fd), "%d", uart_fd);
+		setenv("SIM_UART_FD", fd, 1);
+		setenv("SIM_NAME", image, 1);
+		execl(path, path, (char *)NULL);
+		perror(path);
+		_exit(127);
+	}
+	return pid;
+}
+
+static void SIM_usage(const char *program)
+{
+	fprintf(stderr,
+			"usage: %s [-k keys] [-d duration_ms] [-t time_scale] [-e eeprom_file]\n"
+			"  -k  keypad script of the HMI, e.g. \"@300 12345%% 12345%% @500 +12345%%\"\n"
+			"  -d  simulated time of the run (default " SIM_DEFAULT_DURATION_MS " ms)\n"
+			"  -t  simulated time runs this many times faster than the real time (default " SIM_DEFAULT_TIME_SCALE ")\n"
+			"  -e  file that keeps the 24C16 content between runs\n", program);
+}
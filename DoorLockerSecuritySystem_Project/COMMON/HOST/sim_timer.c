@@ -0,0 +1,194 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim_timer.c
+ *
+ * Description: Model of Timer1 for the host simulation, normal and CTC (OCR1A top) modes
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include "sim.h"
+
+#include <stddef.h>
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+extern void TIMER1_COMPA_vect(void) __attribute__((weak));
+extern void TIMER1_OVF_vect(void) __attribute__((weak));
+
+/* TCNT1 value at g_countTime, the time of its last increment */
+static uint32_t g_count;
+static SIM_Cycles g_countTime;
+
+/* Interrupt flags of TIFR */
+static uint8_t g_flags;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+static uint32_t SIM_timer1Prescaler(void);
+static uint32_t SIM_timer1Period(void);
+static uint32_t SIM_timer1NextEvent(void);
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+void SIM_timer1Init(void)
+{
+	g_count = 0;
+	g_countTime = g_simTime;
+	g_flags = 0;
+}
+
+void SIM_timer1Prepare(SIM_Register reg)
+{
+	uint32_t prescaler = SIM_timer1Prescaler();
+
+	if(reg == SIM_TCNT1)
+	{
+		/* The counter is computed when it is read */
+		g_simRegisters[SIM_TCNT1] = (prescaler == 0) ? g_count :
+				(g_count + (uint32_t)((g_simTime - g_countTime) / prescaler)) % SIM_timer1Period();
+	}
+	else if(reg == SIM_TIFR)
+	{
+		g_simRegisters[SIM_TIFR] = SIM_MARKER | g_flags;
+	}
+}
+
+void SIM_timer1Commit(SIM_Register reg, uint16_t old)
+{
+	uint16_t value = g_simRegisters[reg];
+
+	switch(reg)
+	{
+	case SIM_TCNT1:
+		if(value != old)
+		{
+			g_count = value;
+			g_countTime = g_simTime;
+		}
+		break;
+	case SIM_TCCR1B:
+		/* A stopped timer or a new prescaler counts from now */
+		if((value & 0x07) != (old & 0x07))
+		{
+			g_countTime = g_simTime;
+		}
+		break;
+	case SIM_TIFR:
+		/* The flags are cleared by writing a logical one to them */
+		if(!(value & SIM_MARKER) || (value != old))
+		{
+			g_flags &= (uint8_t)~value;
+		}
+		break;
+	default:
+		break;
+	}
+}
+
+/*
+ * Description :
+ * Count the ticks that elapsed until the given time. The core never jumps over an
+ * event, so at most one compare match or overflow happens here.
+ */
+SIM_Cycles SIM_timer1Update(SIM_Cycles time)
+{
+	uint32_t prescaler = SIM_timer1Prescaler();
+	uint32_t ticks, distance;
+
+	if(prescaler == 0)
+	{
+		g_countTime = time;
+		return SIM_NEVER;
+	}
+
+	distance = SIM_timer1NextEvent();
+	ticks = (uint32_t)((time - g_countTime) / prescaler);
+	if(ticks >= distance)
+	{
+		ticks = distance;
+	}
+	g_count = (g_count + ticks) % SIM_timer1Period();
+	g_countTime += (SIM_Cycles)ticks * prescaler;
+
+	if(ticks == distance)
+	{
+		if(g_count == g_simRegisters[SIM_OCR1A])
+		{
+			g_flags |= (1 << OCF1A);
+		}
+		if(g_count == 0 && !(g_simRegisters[SIM_TCCR1B] & (1 << WGM12)))
+		{
+			g_flags |= (1 << TOV1);
+		}
+	}
+
+	return g_countTime + ((SIM_Cycles)SIM_timer1NextEvent() * prescaler);
+}
+
+SIM_Vector SIM_timer1Pending(void)
+{
+	uint8_t enabled = g_flags & g_simRegisters[SIM_TIMSK];
+
+	if((enabled & (1 << OCF1A)) && TIMER1_COMPA_vect != NULL)
+	{
+		g_flags &= (uint8_t)~(1 << OCF1A);
+		return TIMER1_COMPA_vect;
+	}
+	if((enabled & (1 << TOV1)) && TIMER1_OVF_vect != NULL)
+	{
+		g_flags &= (uint8_t)~(1 << TOV1);
+		return TIMER1_OVF_vect;
+	}
+	return NULL;
+}
+
+/*
+ * Description :
+ * Cycles per count selected by CS12:0, 0 when the timer is stopped.
+ */
+static uint32_t SIM_timer1Prescaler(void)
+{
+	static const uint16_t prescalers[8] = {0, 1, 8, 64, 256, 1024, 0, 0};
+
+	return prescalers[g_simRegisters[SIM_TCCR1B] & 0x07];
+}
+
+/*
+ * Description :
+ * Number of counts before the counter goes back to 0.
+ */
+static uint32_t SIM_timer1Period(void)
+{
+	if((g_simRegisters[SIM_TCCR1B] & (1 << WGM12)) && g_count <= g_simRegisters[SIM_OCR1A])
+	{
+		return (uint32_t)g_simRegisters[SIM_OCR1A] + 1;
+	}
+	return 0x10000;
+}
+
+/*
+ * Description :
+ * Counts from g_count to the next compare match or overflow, always at least one.
+ */
+static uint32_t SIM_timer1NextEvent(void)
+{
+	uint32_t period = SIM_timer1Period();
+	uint32_t compare = g_simRegisters[SIM_OCR1A];
+	uint32_t distance = period - g_count;   /* back to 0 */
+
+	if(compare < period && compare != g_count)
+	{
+		if(((compare + period - g_count) % period) < distance)
+		{
+			distance = (compare + period - g_count) % period;
+		}
+	}
+	return distance;
+}
@@ -0,0 +1,272 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim_twi.c
+ *
+ * Description: Model of the TWI master with a 24C16 EEPROM on the bus for the host simulation
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include "sim.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+#define SIM_EEPROM_SIZE          2048
+#define SIM_EEPROM_PAGE_SIZE     16
+#define SIM_EEPROM_WRITE_TIME    (5 * SIM_CYCLES_PER_MS)   /* tWR of the 24C16 */
+
+/* Device select byte: 1010 A10 A9 A8 R/W */
+#define SIM_EEPROM_DEVICE_MASK   0xF0
+#define SIM_EEPROM_DEVICE        0xA0
+
+/* TWSR status codes */
+#define SIM_TW_START             0x08
+#define SIM_TW_REP_START         0x10
+#define SIM_TW_MT_SLA_W_ACK      0x18
+#define SIM_TW_MT_SLA_W_NACK     0x20
+#define SIM_TW_MT_DATA_ACK       0x28
+#define SIM_TW_MT_DATA_NACK      0x30
+#define SIM_TW_MR_SLA_R_ACK      0x40
+#define SIM_TW_MR_SLA_R_NACK     0x48
+#define SIM_TW_MR_DATA_ACK       0x50
+#define SIM_TW_MR_DATA_NACK      0x58
+#define SIM_TW_NO_INFO           0xF8
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	SIM_BUS_IDLE,     /* no transfer or after a NACK of the address */
+	SIM_BUS_ADDRESS,  /* after a START, the next byte is the device select */
+	SIM_BUS_WORD,     /* the EEPROM waits for the word address */
+	SIM_BUS_WRITE,    /* the EEPROM stores the bytes in its page buffer */
+	SIM_BUS_READ      /* the EEPROM sends the bytes from the current address */
+}SIM_BusState;
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+extern void TWI_vect(void) __attribute__((weak));
+
+static SIM_BusState g_busState = SIM_BUS_IDLE;
+static uint8_t g_master;   /* set from a START to the STOP */
+static uint8_t g_twint;
+static uint8_t g_status = SIM_TW_NO_INFO;
+
+/* 24C16 memory, its address counter and the page being written */
+static uint8_t g_memory[SIM_EEPROM_SIZE];
+static uint16_t g_address;
+static uint8_t g_page[SIM_EEPROM_PAGE_SIZE];
+static uint16_t g_pageWritten;
+static SIM_Cycles g_writeEnd;
+
+/* File that keeps the EEPROM content between runs, -1 when there is none */
+static int g_eepromFd = -1;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+static void SIM_twiAction(uint8_t control);
+static void SIM_eepromSelect(uint8_t device);
+static void SIM_eepromStop(void);
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * The EEPROM is erased (0xFF) or loaded from SIM_EEPROM_FILE when it is given.
+ */
+void SIM_twiInit(void)
+{
+	const char *path = getenv("SIM_EEPROM_FILE");
+
+	memset(g_memory, 0xFF, sizeof(g_memory));
+	if(path != NULL)
+	{
+		g_eepromFd = open(path, O_RDWR | O_CREAT, 0644);
+		if(g_eepromFd >= 0)
+		{
+			(void)pread(g_eepromFd, g_memory, sizeof(g_memory), 0);
+		}
+	}
+}
+
+void SIM_twiPrepare(SIM_Register reg)
+{
+	if(reg == SIM_TWCR)
+	{
+		g_simRegisters[SIM_TWCR] = SIM_MARKER | (g_simRegisters[SIM_TWCR] & 0x7F) | (g_twint ? (1 << TWINT) : 0);
+	}
+	else if(reg == SIM_TWSR)
+	{
+		g_simRegisters[SIM_TWSR] = g_status | (g_simRegisters[SIM_TWSR] & ((1 << TWPS1) | (1 << TWPS0)));
+	}
+}
+
+void SIM_twiCommit(SIM_Register reg, uint16_t old)
+{
+	uint16_t value = g_simRegisters[reg];
+
+	if(reg != SIM_TWCR || ((value & SIM_MARKER) && value == old))
+	{
+		return;   /* only a write to TWCR starts an action */
+	}
+
+	g_simRegisters[SIM_TWCR] = value & (uint8_t)~((1 << TWINT) | (1 << TWSTO));
+	if(!(value & (1 << TWEN)))
+	{
+		g_busState = SIM_BUS_IDLE;
+		g_master = 0;
+		g_twint = 0;
+	}
+	else if(value & (1 << TWINT))
+	{
+		/* Writing a logical one to TWINT clears the flag and starts the next action */
+		g_twint = 0;
+		SIM_twiAction((uint8_t)value);
+	}
+}
+
+SIM_Cycles SIM_twiUpdate(SIM_Cycles time)
+{
+	return (g_writeEnd > time) ? g_writeEnd : SIM_NEVER;
+}
+
+SIM_Vector SIM_twiPending(void)
+{
+	if(g_twint && (g_simRegisters[SIM_TWCR] & (1 << TWIE)) && TWI_vect != NULL)
+	{
+		return TWI_vect;
+	}
+	return NULL;
+}
+
+/*
+ * Description :
+ * Do the bus action of a TWCR write, it completes at once: STOP, START, one byte
+ * sent or one byte received. TWINT is set again after everything but a STOP.
+ */
+static void SIM_twiAction(uint8_t control)
+{
+	uint8_t data = (uint8_t)g_simRegisters[SIM_TWDR];
+
+	if(control & (1 << TWSTO))
+	{
+		SIM_eepromStop();
+		g_master = 0;
+		g_status = SIM_TW_NO_INFO;
+		if(!(control & (1 << TWSTA)))
+		{
+			return;
+		}
+	}
+
+	if(control & (1 << TWSTA))
+	{
+		g_status = g_master ? SIM_TW_REP_START : SIM_TW_START;
+		g_master = 1;
+		g_busState = SIM_BUS_ADDRESS;
+	}
+	else
+	{
+		switch(g_busState)
+		{
+		case SIM_BUS_ADDRESS:
+			SIM_eepromSelect(data);
+			break;
+		case SIM_BUS_WORD:
+			g_address = (g_address & 0x700) | data;
+			g_pageWritten = 0;
+			g_busState = SIM_BUS_WRITE;
+			g_status = SIM_TW_MT_DATA_ACK;
+			break;
+		case SIM_BUS_WRITE:
+			/* The page buffer rolls over inside the page like the 24C16 */
+			g_page[(g_address + g_pageWritten) % SIM_EEPROM_PAGE_SIZE] = data;
+			if(g_pageWritten < SIM_EEPROM_PAGE_SIZE)
+			{
+				g_pageWritten++;
+			}
+			g_status = SIM_TW_MT_DATA_ACK;
+			break;
+		case SIM_BUS_READ:
+			g_simRegisters[SIM_TWDR] = g_memory[g_address];
+			g_address = (g_address + 1) % SIM_EEPROM_SIZE;
+			g_status = (control & (1 << TWEA)) ? SIM_TW_MR_DATA_ACK : SIM_TW_MR_DATA_NACK;
+			break;
+		default:
+			/* Nobody answers on the bus */
+			g_status = SIM_TW_MT_DATA_NACK;
+			break;
+		}
+	}
+	g_twint = 1;
+}
+
+/*
+ * Description :
+ * Device select byte after a START: the 24C16 answers to 1010xxx when it is not busy
+ * with a write cycle, its three low bits are the block of 256 bytes.
+ */
+static void SIM_eepromSelect(uint8_t device)
+{
+	uint8_t reading = device & 0x01;
+
+	if((device & SIM_EEPROM_DEVICE_MASK) != SIM_EEPROM_DEVICE || g_simTime < g_writeEnd)
+	{
+		g_busState = SIM_BUS_IDLE;
+		g_status = reading ? SIM_TW_MR_SLA_R_NACK : SIM_TW_MT_SLA_W_NACK;
+		return;
+	}
+
+	if(reading)
+	{
+		g_busState = SIM_BUS_READ;
+		g_status = SIM_TW_MR_SLA_R_ACK;
+	}
+	else
+	{
+		g_address = (uint16_t)((device & 0x0E) << 7);
+		g_busState = SIM_BUS_WORD;
+		g_status = SIM_TW_MT_SLA_W_ACK;
+	}
+}
+
+/*
+ * Description :
+ * A STOP after data bytes starts the internal write cycle of the page.
+ */
+static void SIM_eepromStop(void)
+{
+	uint16_t page_start = g_address & (uint16_t)~(SIM_EEPROM_PAGE_SIZE - 1);
+	uint16_t i, offset;
+
+	if(g_busState == SIM_BUS_WRITE && g_pageWritten != 0)
+	{
+		for(i = 0 ; i < g_pageWritten ; i++)
+		{
+			offset = (g_address + i) % SIM_EEPROM_PAGE_SIZE;
+			g_memory[page_start + offset] = g_page[offset];
+		}
+		g_writeEnd = g_simTime + SIM_EEPROM_WRITE_TIME;
+		if(g_eepromFd >= 0)
+		{
+			(void)pwrite(g_eepromFd, &g_memory[page_start], SIM_EEPROM_PAGE_SIZE, page_start);
+		}
+		g_address = page_start + ((g_address + g_pageWritten) % SIM_EEPROM_PAGE_SIZE);
+	}
+	g_busState = SIM_BUS_IDLE;
+}
@@ -0,0 +1,214 @@
+ /******************************************************************************
+ *
+ * Module: HOST
+ *
+ * File Name: sim_uart.c
+ *
+ * Description: Model of the USART for the host simulation, the line is a file
+ *              descriptor given by the launcher (socketpair or pty)
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include "sim.h"
+
+#include <fcntl.h>
+#include <stddef.h>
+#include <stdlib.h>
+#include <unistd.h>
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Receive FIFO of the USART: UDR buffer, one more buffer and the shift register */
+#define SIM_UART_RX_FIFO_SIZE   3
+
+/*******************************************************************************
+ *                           Global Variables                                  *
+ *******************************************************************************/
+extern void USART_RXC_vect(void) __attribute__((weak));
+extern void USART_UDRE_vect(void) __attribute__((weak));
+extern void USART_TXC_vect(void) __attribute__((weak));
+
+/* Line to the other ECU, -1 when the ECU runs alone */
+static int g_uartFd = -1;
+
+/* Transmitter: the shift register sends its byte until g_txEnd, UDR waits behind it */
+static uint8_t g_txShifting;
+static uint8_t g_txShiftByte;
+static SIM_Cycles g_txEnd;
+static uint8_t g_txFull;
+static uint8_t g_txByte;
+static uint8_t g_txComplete;
+
+/* Receiver */
+static uint8_t g_rxFifo[SIM_UART_RX_FIFO_SIZE];
+static uint8_t g_rxCount;
+
+/*******************************************************************************
+ *                      Private Functions Prototypes                           *
+ *******************************************************************************/
+static SIM_Cycles SIM_uartFrameCycles(void);
+static void SIM_uartStartByte(uint8_t data, SIM_Cycles start);
+
+/*******************************************************************************
+ *                              Functions Definitions                          *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * SIM_UART_FD is the descriptor of the line, it is made non-blocking because the
+ * receiver polls it from the models.
+ */
+void SIM_uartInit(void)
+{
+	const char *value = getenv("SIM_UART_FD");
+
+	if(value != NULL)
+	{
+		g_uartFd = atoi(value);
+		fcntl(g_uartFd, F_SETFL, fcntl(g_uartFd, F_GETFL) | O_NONBLOCK);
+	}
+}
+
+void SIM_uartPrepare(SIM_Register reg)
+{
+	uint8_t status;
+
+	if(reg == SIM_UDR)
+	{
+		g_simRegisters[SIM_UDR] = SIM_MARKER | g_rxFifo[0];
+	}
+	else if(reg == SIM_UCSRA)
+	{
+		status = g_simRegisters[SIM_UCSRA] & ((1 << U2X) | (1 << MPCM));
+		status |= (g_rxCount != 0) ? (1 << RXC) : 0;
+		status |= g_txComplete ? (1 << TXC) : 0;
+		status |= g_txFull ? 0 : (1 << UDRE);
+		g_simRegisters[SIM_UCSRA] = status;
+	}
+}
+
+void SIM_uartCommit(SIM_Register reg, uint16_t old)
+{
+	uint16_t value = g_simRegisters[reg];
+	uint8_t i;
+
+	if(reg == SIM_UDR)
+	{
+		if(value & SIM_MARKER)
+		{
+			/* A read: the next received byte moves to UDR */
+			if(g_rxCount != 0)
+			{
+				for(i = 1 ; i < g_rxCount ; i++)
+				{
+					g_rxFifo[i - 1] = g_rxFifo[i];
+				}
+				g_rxCount--;
+			}
+		}
+		else if(g_simRegisters[SIM_UCSRB] & (1 << TXEN))
+		{
+			/* A write: the byte goes to the shift register or waits in UDR */
+			if(!g_txShifting)
+			{
+				SIM_uartStartByte((uint8_t)value, g_simTime);
+			}
+			else
+			{
+				g_txFull = 1;
+				g_txByte = (uint8_t)value;
+			}
+		}
+	}
+	else if(reg == SIM_UCSRA && value != old && (value & (1 << TXC)))
+	{
+		g_txComplete = 0;   /* TXC is cleared by writing a logical one to it */
+	}
+}
+
+/*
+ * Description :
+ * Finish the byte being sent and receive the bytes of the line when there is space in the FIFO.
+ */
+SIM_Cycles SIM_uartUpdate(SIM_Cycles time)
+{
+	ssize_t count;
+
+	if(g_txShifting && g_txEnd <= time)
+	{
+		if(g_uartFd >= 0)
+		{
+			(void)write(g_uartFd, &g_txShiftByte, 1);
+		}
+		g_txShifting = 0;
+		if(g_txFull)
+		{
+			g_txFull = 0;
+			SIM_uartStartByte(g_txByte, g_txEnd);
+		}
+		else
+		{
+			g_txComplete = 1;
+		}
+	}
+
+	if(g_uartFd >= 0 && (g_simRegisters[SIM_UCSRB] & (1 << RXEN)) && g_rxCount < SIM_UART_RX_FIFO_SIZE)
+	{
+		count = read(g_uartFd, &g_rxFifo[g_rxCount], SIM_UART_RX_FIFO_SIZE - g_rxCount);
+		if(count > 0)
+		{
+			g_rxCount += (uint8_t)count;
+		}
+	}
+
+	return g_txShifting ? g_txEnd : SIM_NEVER;
+}
+
+SIM_Vector SIM_uartPending(void)
+{
+	uint8_t control = (uint8_t)g_simRegisters[SIM_UCSRB];
+
+	if((control & (1 << RXCIE)) && g_rxCount != 0 && USART_RXC_vect != NULL)
+	{
+		return USART_RXC_vect;
+	}
+	if((control & (1 << UDRIE)) && !g_txFull && USART_UDRE_vect != NULL)
+	{
+		return USART_UDRE_vect;
+	}
+	if((control & (1 << TXCIE)) && g_txComplete && USART_TXC_vect != NULL)
+	{
+		g_txComplete = 0;
+		return USART_TXC_vect;
+	}
+	return NULL;
+}
+
+/*
+ * Description :
+ * Cycles of one frame: start bit, data bits, parity bit and stop bits at the UBRR baud rate.
+ */
+static SIM_Cycles SIM_uartFrameCycles(void)
+{
+	static const uint8_t data_bits[8] = {5, 6, 7, 8, 8, 8, 8, 9};
+	uint8_t control = (uint8_t)g_simRegisters[SIM_UCSRC];
+	uint32_t ubrr = ((uint32_t)(g_simRegisters[SIM_UBRRH] & 0x0F) << 8) | g_simRegisters[SIM_UBRRL];
+	uint32_t bits;
+
+	bits = 1 + data_bits[((control >> UCSZ0) & 0x03) | ((g_simRegisters[SIM_UCSRB] & (1 << UCSZ2)) ? 4 : 0)];
+	bits += (control & (1 << UPM1)) ? 1 : 0;
+	bits += (control & (1 << USBS)) ? 2 : 1;
+
+	return (SIM_Cycles)bits * ((g_simRegisters[SIM_UCSRA] & (1 << U2X)) ? 8 : 16) * (ubrr + 1);
+}
+
+static void SIM_uartStartByte(uint8_t data, SIM_Cycles start)
+{
+	g_txShifting = 1;
+	g_txShiftByte = data;
+	g_txEnd = start + SIM_uartFrameCycles();
+	g_txComplete = 0;
+}
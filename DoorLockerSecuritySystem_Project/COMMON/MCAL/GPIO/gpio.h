@@ -14,6 +14,7 @@
 #define GPIO_H_
 
 #include "../std_types.h"
+#include <avr/io.h>                /* To use the IO Ports Registers in the compile time pin access macros */
 
 /*******************************************************************************
  *                                Definitions                                  *
@@ -35,6 +36,59 @@
 #define PIN6_ID                6
 #define PIN7_ID                7
 
+/*
+ * Compile time pin access:
+ * The port ID should be one of PORTA_ID --> PORTD_ID (or a macro defined as one of them),
+ * then the port register is chosen by the preprocessor and an access with a constant pin number
+ * is only one sbi/cbi/sbic/sbis instruction, which is also atomic with respect to the interrupts.
+ * The GPIO functions are still used when the port number is only known at run time.
+ */
+#define GPIO_PORT_REG_0        PORTA
+#define GPIO_PORT_REG_1        PORTB
+#define GPIO_PORT_REG_2        PORTC
+#define GPIO_PORT_REG_3        PORTD
+
+#define GPIO_DDR_REG_0         DDRA
+#define GPIO_DDR_REG_1         DDRB
+#define GPIO_DDR_REG_2         DDRC
+#define GPIO_DDR_REG_3         DDRD
+
+#define GPIO_PIN_REG_0         PINA
+#define GPIO_PIN_REG_1         PINB
+#define GPIO_PIN_REG_2         PINC
+#define GPIO_PIN_REG_3         PIND
+
+/* The extra level lets the port ID macro expand to its number before the concatenation */
+#define GPIO_CONCAT(a,b)        GPIO_CONCAT_EXPAND(a,b)
+#define GPIO_CONCAT_EXPAND(a,b) a##b
+
+#define GPIO_PORT_REG(port_id) GPIO_CONCAT(GPIO_PORT_REG_,port_id)
+#define GPIO_DDR_REG(port_id)  GPIO_CONCAT(GPIO_DDR_REG_,port_id)
+#define GPIO_PIN_REG(port_id)  GPIO_CONCAT(GPIO_PIN_REG_,port_id)
+
+/* Same as GPIO_setupPinDirection */
+#define GPIO_SETUP_PIN_DIRECTION(port_id,pin_num,direction) \
+	(((direction) == PIN_OUTPUT) ? (void)(GPIO_DDR_REG(port_id) |= (uint8)(1<<(pin_num))) \
+	                             : (void)(GPIO_DDR_REG(port_id) &= (uint8)~(1<<(pin_num))))
+
+/* Same as GPIO_writePin */
+#define GPIO_WRITE_PIN(port_id,pin_num,value) \
+	(((value) == LOGIC_HIGH) ? (void)(GPIO_PORT_REG(port_id) |= (uint8)(1<<(pin_num))) \
+	                         : (void)(GPIO_PORT_REG(port_id) &= (uint8)~(1<<(pin_num))))
+
+/* Same as GPIO_readPin */
+#define GPIO_READ_PIN(port_id,pin_num) \
+	((uint8)((GPIO_PIN_REG(port_id) & (1<<(pin_num))) ? LOGIC_HIGH : LOGIC_LOW))
+
+/* Same as GPIO_setupPortDirection */
+#define GPIO_SETUP_PORT_DIRECTION(port_id,direction) (GPIO_DDR_REG(port_id) = (uint8)(direction))
+
+/* Same as GPIO_writePort */
+#define GPIO_WRITE_PORT(port_id,value) (GPIO_PORT_REG(port_id) = (uint8)(value))
+
+/* Same as GPIO_readPort */
+#define GPIO_READ_PORT(port_id) (GPIO_PIN_REG(port_id))
+
 /*******************************************************************************
  *                               Types Declaration                             *
  *******************************************************************************/
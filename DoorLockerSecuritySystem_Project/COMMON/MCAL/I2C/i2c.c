@@ -0,0 +1,409 @@
+ /******************************************************************************
+ *
+ * Module: TWI(I2C)
+ *
+ * File Name: twi.h
+ *
+ * Description: Source file for the TWI(I2C) AVR driver
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+ 
+#include "i2c.h"
+#include <avr/io.h>
+#include <avr/interrupt.h>
+#include <util/delay.h>
+#include <avr/pgmspace.h>          /* To read the configurations from the program memory */
+#include "../common_macros.h"
+#include "../GPIO/gpio.h"          /* To drive SCL & SDA in the bus recovery */
+
+/*******************************************************************************
+*                            Global Variables                                  *
+*******************************************************************************/
+/* Transactions waiting for the bus, the application adds at g_queueHead and the engine takes from g_queueTail */
+static TWI_Transaction *volatile g_queue[TWI_QUEUE_SIZE];
+static volatile uint8 g_queueHead = 0;
+static volatile uint8 g_queueTail = 0;
+
+/* The transaction on the bus now, NULL_PTR when the engine is idle */
+static TWI_Transaction *volatile g_current = NULL_PTR;
+
+/* Index of the next byte to be sent or received in the current transaction */
+static volatile uint16 g_index = 0;
+
+/* TRUE when the current transaction is in its read part */
+static volatile boolean g_reading = FALSE;
+
+/* Incremented by the ISR on every bus event, so a waiter can tell a slow bus from a stuck one */
+static volatile uint8 g_progress = 0;
+
+/* TRUE when the last blocking operation didn't end within TWI_TIMEOUT_US */
+static boolean g_timeout = FALSE;
+
+/* Copy of the configurations, used to initialize the TWI again after the bus recovery */
+static TWI_ConfigType g_config;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                           *
+*******************************************************************************/
+/*
+ * Take the next transaction from the queue and send its start bit.
+ * stop_bit is (1<<TWSTO) to end the previous transaction first, or 0 if the bus is free.
+ * It must be called with the TWI interrupt not able to run.
+ */
+static void TWI_startNext(uint8 stop_bit);
+
+/* End the current transaction with the required status and go to the next one */
+static void TWI_finish(TWI_TransactionStatus status);
+
+/* Set the TWI registers from g_config */
+static void TWI_setup(void);
+
+/* Wait for the TWINT flag, return FALSE if it is not set within TWI_TIMEOUT_US */
+static boolean TWI_waitForFlag(void);
+
+/*******************************************************************************
+*                                   ISRs                                       *
+*******************************************************************************/
+ISR(TWI_vect)
+{
+	TWI_Transaction *transaction = g_current;
+
+	g_progress++;
+
+	/* masking to get the status bits */
+	switch(TWSR & 0xF8)
+	{
+	case TWI_START:
+	case TWI_REP_START:
+		/* Send the slave address with the R/W bit of the current part */
+		TWDR = g_reading ? (transaction->slave_address | 1) : transaction->slave_address;
+		g_index = 0;
+		TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+		break;
+
+	case TWI_MT_SLA_W_ACK:
+	case TWI_MT_DATA_ACK:
+		if(g_index < transaction->write_size)
+		{
+			TWDR = transaction->write_data[g_index++];
+			TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE);
+		}
+		else if(transaction->read_size != 0)
+		{
+			/* Switch to the read part with a repeated start */
+			g_reading = TRUE;
+			TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+		}
+		else
+		{
+			TWI_finish(TWI_TRANSACTION_DONE);
+		}
+		break;
+
+	case TWI_MT_SLA_R_ACK:
+		/* Acknowledge the received bytes except the last one */
+		TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE) | ((transaction->read_size > 1) << TWEA);
+		break;
+
+	case TWI_MR_DATA_ACK:
+		transaction->read_data[g_index++] = TWDR;
+		TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWIE) | (((transaction->read_size - g_index) > 1) << TWEA);
+		break;
+
+	case TWI_MR_DATA_NACK:
+		/* The last byte */
+		transaction->read_data[g_index] = TWDR;
+		TWI_finish(TWI_TRANSACTION_DONE);
+		break;
+
+	default:
+		/* NACK from the slave, arbitration lost or a bus error */
+		TWI_finish(TWI_TRANSACTION_ERROR);
+		break;
+	}
+}
+
+/*******************************************************************************
+*                       Functions Definitions                                  *
+*******************************************************************************/
+
+void TWI_init(const TWI_ConfigType *Config_Ptr)
+{
+    g_config = *Config_Ptr;
+
+    /* Start with an idle engine */
+    g_queueHead = g_queueTail = 0;
+    g_current = NULL_PTR;
+
+    TWI_setup();
+}
+
+void TWI_init_P(const TWI_ConfigType *Config_Ptr)
+{
+    TWI_ConfigType config;
+
+    memcpy_P(&config, Config_Ptr, sizeof(config));
+    TWI_init(&config);
+}
+
+void TWI_start(void)
+{
+    /* 
+	 * Clear the TWINT flag before sending the start bit TWINT=1
+	 * send the start bit by TWSTA=1
+	 * Enable TWI Module TWEN=1 
+	 */
+    TWCR = (1 << TWINT) | (1 << TWSTA) | (1 << TWEN);
+    
+    /* Wait for TWINT flag set in TWCR Register (start bit is send successfully) */
+    TWI_waitForFlag();
+}
+
+void TWI_stop(void)
+{
+    /* 
+	 * Clear the TWINT flag before sending the stop bit TWINT=1
+	 * send the stop bit by TWSTO=1
+	 * Enable TWI Module TWEN=1 
+	 */
+    TWCR = (1 << TWINT) | (1 << TWSTO) | (1 << TWEN);
+}
+
+void TWI_writeByte(uint8 data)
+{
+    /* Put data On TWI data Register */
+    TWDR = data;
+    /* 
+	 * Clear the TWINT flag before sending the data TWINT=1
+	 * Enable TWI Module TWEN=1 
+	 */ 
+    TWCR = (1 << TWINT) | (1 << TWEN);
+    /* Wait for TWINT flag set in TWCR Register(data is send successfully) */
+    TWI_waitForFlag();
+}
+
+uint8 TWI_readByteWithACK(void)
+{
+	/* 
+	 * Clear the TWINT flag before reading the data TWINT=1
+	 * Enable sending ACK after reading or receiving data TWEA=1
+	 * Enable TWI Module TWEN=1 
+	 */ 
+    TWCR = (1 << TWINT) | (1 << TWEN) | (1 << TWEA);
+    /* Wait for TWINT flag set in TWCR Register (data received successfully) */
+    TWI_waitForFlag();
+    /* Read Data */
+    return TWDR;
+}
+
+uint8 TWI_readByteWithNACK(void)
+{
+	/* 
+	 * Clear the TWINT flag before reading the data TWINT=1
+	 * Enable TWI Module TWEN=1 
+	 */
+    TWCR = (1 << TWINT) | (1 << TWEN);
+    /* Wait for TWINT flag set in TWCR Register (data received successfully) */
+    TWI_waitForFlag();
+    /* Read Data */
+    return TWDR;
+}
+
+uint8 TWI_getStatus(void)
+{
+    uint8 status;
+
+    /* The status register is not updated if the last operation didn't end */
+    if(g_timeout)
+    {
+        return TWI_BUS_TIMEOUT;
+    }
+
+    /* masking to eliminate first 3 bits and get the last 5 bits (status bits) */
+    status = TWSR & 0xF8;
+    return status;
+}
+
+boolean TWI_submit(TWI_Transaction *transaction)
+{
+	uint8 next_head;
+	uint8 sreg;
+
+	next_head = (uint8)((g_queueHead + 1) & (TWI_QUEUE_SIZE - 1));
+	if(next_head == g_queueTail)
+	{
+		return FALSE;
+	}
+
+	transaction->status = TWI_TRANSACTION_PENDING;
+	g_queue[g_queueHead] = transaction;
+
+	/* The ISR must not check the queue between adding the transaction and starting the engine */
+	sreg = SREG;
+	cli();
+
+	g_queueHead = next_head;
+	if(g_current == NULL_PTR)
+	{
+		TWI_startNext(0);
+	}
+
+	SREG = sreg;
+	return TRUE;
+}
+
+boolean TWI_isBusy(void)
+{
+	return (g_current != NULL_PTR);
+}
+
+TWI_TransactionStatus TWI_waitTransaction(TWI_Transaction *transaction)
+{
+	uint8 last_progress = g_progress;
+	uint16 waited_us = 0;
+
+	while((transaction->status == TWI_TRANSACTION_PENDING) || (transaction->status == TWI_TRANSACTION_BUSY))
+	{
+		if(g_progress != last_progress)
+		{
+			/* The engine is still working, even if it is on another transaction */
+			last_progress = g_progress;
+			waited_us = 0;
+		}
+		else if(waited_us >= TWI_TIMEOUT_US)
+		{
+			TWI_recoverBus();
+			waited_us = 0;
+		}
+		else
+		{
+			_delay_us(1);
+			waited_us++;
+		}
+	}
+	return transaction->status;
+}
+
+void TWI_recoverBus(void)
+{
+	uint8 idx;
+	uint8 sreg;
+
+	sreg = SREG;
+	cli();
+
+	/* Disable the TWI, so the pins are GPIO pins again */
+	TWCR = 0;
+
+	/* The pins are driven like open drain: output low for logic 0, input for logic 1 (the bus pull-ups) */
+	GPIO_WRITE_PIN(TWI_PORT_ID,TWI_SCL_PIN_ID,LOGIC_LOW);
+	GPIO_WRITE_PIN(TWI_PORT_ID,TWI_SDA_PIN_ID,LOGIC_LOW);
+	GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SDA_PIN_ID,PIN_INPUT);
+
+	/* Nine clocks let a slave finish the byte it is sending and release SDA */
+	for(idx = 0; idx < 9; idx++)
+	{
+		GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SCL_PIN_ID,PIN_OUTPUT);
+		_delay_us(5);
+		GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SCL_PIN_ID,PIN_INPUT);
+		_delay_us(5);
+	}
+
+	/* Stop condition: SDA goes high while SCL is high */
+	GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SCL_PIN_ID,PIN_OUTPUT);
+	GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SDA_PIN_ID,PIN_OUTPUT);
+	_delay_us(5);
+	GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SCL_PIN_ID,PIN_INPUT);
+	_delay_us(5);
+	GPIO_SETUP_PIN_DIRECTION(TWI_PORT_ID,TWI_SDA_PIN_ID,PIN_INPUT);
+	_delay_us(5);
+
+	TWI_setup();
+	g_timeout = FALSE;
+
+	/* End the stuck transaction and go on with the queued ones */
+	if(g_current != NULL_PTR)
+	{
+		g_current->status = TWI_TRANSACTION_TIMEOUT;
+		if(g_current->callBack != NULL_PTR)
+		{
+			g_current->callBack(g_current);
+		}
+	}
+	TWI_startNext(0);
+
+	SREG = sreg;
+}
+
+/*******************************************************************************
+*                       Private Functions Definitions                          *
+*******************************************************************************/
+static void TWI_startNext(uint8 stop_bit)
+{
+	if(g_queueTail != g_queueHead)
+	{
+		g_current = g_queue[g_queueTail];
+		g_queueTail = (uint8)((g_queueTail + 1) & (TWI_QUEUE_SIZE - 1));
+
+		g_current->status = TWI_TRANSACTION_BUSY;
+		g_reading = (g_current->write_size == 0) && (g_current->read_size != 0);
+
+		/* If both TWSTO and TWSTA are set the stop bit is sent then the start bit */
+		TWCR = (1 << TWINT) | stop_bit | (1 << TWSTA) | (1 << TWEN) | (1 << TWIE);
+	}
+	else
+	{
+		g_current = NULL_PTR;
+
+		/* Nothing left, release the bus and disable the interrupt */
+		TWCR = (1 << TWINT) | stop_bit | (1 << TWEN);
+	}
+}
+
+static void TWI_setup(void)
+{
+    /* Bit Rate: 400.000 kbps using zero pre-scaler TWPS=00 and F_CPU=8Mhz */
+    TWBR = g_config.bit_rate;
+	TWSR = 0x00;
+	
+    /* Two Wire Bus address my address if any master device want to call me: 0x1 (used in case this MC is a slave device)
+       General Call Recognition: Off */
+    TWAR = (g_config.address << 1);
+	
+    TWCR = (1<<TWEN); /* enable TWI */
+}
+
+static boolean TWI_waitForFlag(void)
+{
+	uint16 waited_us;
+
+	for(waited_us = 0; waited_us < TWI_TIMEOUT_US; waited_us++)
+	{
+		if(BIT_IS_SET(TWCR,TWINT))
+		{
+			g_timeout = FALSE;
+			return TRUE;
+		}
+		_delay_us(1);
+	}
+
+	/* SDA or SCL is held by a slave or the bus has no pull-ups */
+	g_timeout = TRUE;
+	return FALSE;
+}
+
+static void TWI_finish(TWI_TransactionStatus status)
+{
+	TWI_Transaction *transaction = g_current;
+
+	transaction->status = status;
+	if(transaction->callBack != NULL_PTR)
+	{
+		/* it can submit a new transaction, it will start after the queued ones */
+		transaction->callBack(transaction);
+	}
+
+	TWI_startNext(1 << TWSTO);
+}
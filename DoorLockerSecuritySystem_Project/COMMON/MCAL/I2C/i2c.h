@@ -0,0 +1,150 @@
+ /******************************************************************************
+ *
+ * Module: TWI(I2C)
+ *
+ * File Name: i2c.h
+ *
+ * Description: Header file for the TWI(I2C) AVR driver
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/ 
+
+#ifndef I2C_H_
+#define I2C_H_
+
+#include "../std_types.h"
+
+/*******************************************************************************
+*                           Type Declarations                                  *
+*******************************************************************************/
+typedef uint8 TWI_Address;
+
+typedef uint16 TWI_BaudRate;
+
+typedef struct
+{
+ TWI_Address address;
+ TWI_BaudRate bit_rate;
+}TWI_ConfigType;
+
+typedef enum
+{
+ TWI_TRANSACTION_PENDING,TWI_TRANSACTION_BUSY,TWI_TRANSACTION_DONE,TWI_TRANSACTION_ERROR,TWI_TRANSACTION_TIMEOUT
+}TWI_TransactionStatus;
+
+/*
+ * One transaction of the interrupt driven engine, it can be:
+ * 1. A write: write_size bytes are sent after SLA+W (write_size can be 0 to only check the slave ACK).
+ * 2. A read: read_size bytes are received after SLA+R.
+ * 3. A write then read: the write is followed by a repeated start and the read.
+ * The transaction and its buffers must stay valid until its status is DONE or ERROR.
+ */
+typedef struct TWI_Transaction
+{
+ uint8 slave_address;                     /* SLA+W, the engine sets the R/W bit itself */
+ const uint8 *write_data;
+ uint16 write_size;
+ uint8 *read_data;
+ uint16 read_size;
+ volatile TWI_TransactionStatus status;
+ void (*callBack)(struct TWI_Transaction *transaction); /* called from the ISR when the transaction ends, can be NULL_PTR */
+}TWI_Transaction;
+
+/*******************************************************************************
+*                                Definitions                                   *
+*******************************************************************************/
+/* I2C bit rate can be calculated using the formula:
+ * 400K Bits/Sec = 400,000 bits/sec.
+ * Bit Rate = F_CPU / (16 + (2 * TWBR * Prescaler))
+ * Prescaler is 1 for standard mode, where the fastest possible bit rate is achieved.
+ * TWBR = (F_CPU / (4 * Bit Rate)) - 16
+ * For an 8MHz clock, the TWBR value for 400K Bits/Sec:
+ * TWBR = (8,000,000 / (4 * 400,000)) - 16 = 49
+ * */
+#define I2C_BAUD_RATE_400K 0x02
+#define I2C_BAUD_RATE_100K 0x10
+
+/* I2C Status Bits in the TWSR Register */
+#define TWI_START         0x08 /* start has been sent */
+#define TWI_REP_START     0x10 /* repeated start */
+#define TWI_MT_SLA_W_ACK  0x18 /* Master transmit ( slave address + Write request ) to slave + ACK received from slave. */
+#define TWI_MT_SLA_R_ACK  0x40 /* Master transmit ( slave address + Read request ) to slave + ACK received from slave. */
+#define TWI_MT_DATA_ACK   0x28 /* Master transmit data and ACK has been received from Slave. */
+#define TWI_MR_DATA_ACK   0x50 /* Master received data and send ACK to slave. */
+#define TWI_MR_DATA_NACK  0x58 /* Master received data but doesn't send ACK to slave. */
+#define TWI_MT_SLA_W_NACK 0x20 /* Master transmit ( slave address + Write request ) to slave + NACK received from slave. */
+#define TWI_MT_DATA_NACK  0x30 /* Master transmit data and NACK has been received from Slave. */
+#define TWI_ARB_LOST      0x38 /* Arbitration lost in slave address or data bytes. */
+#define TWI_MR_SLA_R_NACK 0x48 /* Master transmit ( slave address + Read request ) to slave + NACK received from slave. */
+#define TWI_BUS_TIMEOUT   0x01 /* Not a TWSR code: the last operation didn't end within TWI_TIMEOUT_US. */
+
+/* Max time for one bus operation (start, one byte or stop) to end before the bus is considered stuck */
+#define TWI_TIMEOUT_US    1000
+
+/* TWI pins, they are driven as GPIO pins by the bus recovery */
+#define TWI_PORT_ID       PORTC_ID
+#define TWI_SCL_PIN_ID    PIN0_ID
+#define TWI_SDA_PIN_ID    PIN1_ID
+
+/* Max number of transactions waiting in the engine queue, it should be a power of 2 */
+#define TWI_QUEUE_SIZE    4
+
+#if((TWI_QUEUE_SIZE & (TWI_QUEUE_SIZE - 1)) || (TWI_QUEUE_SIZE > 256))
+#error "TWI_QUEUE_SIZE should be a power of 2 and not more than 256"
+#endif
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description :
+ * Initialize the TWI, the blocking functions below stop waiting after TWI_TIMEOUT_US
+ * and TWI_getStatus returns TWI_BUS_TIMEOUT in this case.
+ */
+void TWI_init(const TWI_ConfigType *Config_Ptr);
+
+/*
+ * Description :
+ * Same as TWI_init but the configurations are in the program memory (PROGMEM).
+ */
+void TWI_init_P(const TWI_ConfigType *Config_Ptr);
+void TWI_start(void);
+void TWI_stop(void);
+void TWI_writeByte(uint8 data);
+uint8 TWI_readByteWithACK(void);
+uint8 TWI_readByteWithNACK(void);
+uint8 TWI_getStatus(void);
+
+/*
+ * Description :
+ * Queue a transaction for the interrupt driven engine and start it if the bus is idle.
+ * Return FALSE if the queue is full.
+ * The blocking functions above must not be used while the engine is busy.
+ */
+boolean TWI_submit(TWI_Transaction *transaction);
+
+/*
+ * Description :
+ * Return TRUE while the engine is doing a transaction.
+ */
+boolean TWI_isBusy(void);
+
+/*
+ * Description :
+ * Wait until the transaction ends and return its status.
+ * If the engine makes no progress for TWI_TIMEOUT_US the transaction on the bus ends
+ * with TWI_TRANSACTION_TIMEOUT and the bus is recovered.
+ */
+TWI_TransactionStatus TWI_waitTransaction(TWI_Transaction *transaction);
+
+/*
+ * Description :
+ * Free a stuck bus: clock SCL nine times so a slave holding SDA low can finish its byte,
+ * send a stop condition and initialize the TWI again.
+ * The transaction on the bus (if any) ends with TWI_TRANSACTION_TIMEOUT and the queued ones are started.
+ */
+void TWI_recoverBus(void);
+
+
+#endif /* TWI_H_ */
@@ -0,0 +1,160 @@
+/*
+ * Module: Software Timers
+ *
+ * File Name: swtimer.c
+ *
+ * Description: Source file for the software timers service, it runs many one-shot or periodic
+ *              timers with their own callbacks on one Timer1 compare interrupt (the tick).
+ *
+ *  Author: AS.Mahrous
+ */
+
+#include "swtimer.h"
+#include <avr/io.h>             /* To use the SREG Register */
+#include <avr/interrupt.h>
+#include <avr/pgmspace.h>       /* To read the configurations from the program memory */
+
+/*******************************************************************************
+*                           Type Declarations                                  *
+*******************************************************************************/
+typedef struct
+{
+	uint16 period;
+	uint16 remaining;              /* ticks left, 0 means the timer is stopped */
+	SWTIMER_Mode mode;
+	void (*callBackPtr)(void);
+}SWTIMER_Timer;
+
+/*******************************************************************************
+*                            Global Variables                                  *
+*******************************************************************************/
+static volatile SWTIMER_Timer g_timers[SWTIMER_MAX_TIMERS];
+
+/* Free running tick counter */
+static volatile uint32 g_ticks = 0;
+
+/*******************************************************************************
+*                      Functions Prototypes(Private)                           *
+*******************************************************************************/
+/* The Timer1 callback, it is called every tick from the Timer1 ISR */
+static void SWTIMER_tick(void);
+
+/*******************************************************************************
+*                       Functions Definitions                                  *
+*******************************************************************************/
+
+void SWTIMER_init(const TIMER1_configType * Config_Ptr)
+{
+	SWTIMER_Id id;
+
+	for(id = 0; id < SWTIMER_MAX_TIMERS; id++)
+	{
+		g_timers[id].remaining = 0;
+	}
+	g_ticks = 0;
+
+	/* Set the callback first, so the first tick is not missed */
+	TIMER1_setCallBack(SWTIMER_tick);
+	TIMER1_init(Config_Ptr);
+}
+
+void SWTIMER_init_P(const TIMER1_configType * Config_Ptr)
+{
+	TIMER1_configType config;
+
+	memcpy_P(&config, Config_Ptr, sizeof(config));
+	SWTIMER_init(&config);
+}
+
+boolean SWTIMER_start(SWTIMER_Id id, uint16 period_ticks, SWTIMER_Mode mode, void(*a_ptr)(void))
+{
+	uint8 sreg;
+
+	if((id >= SWTIMER_MAX_TIMERS) || (period_ticks == 0))
+	{
+		return FALSE;
+	}
+
+	/* The tick must not see the timer half updated */
+	sreg = SREG;
+	cli();
+
+	g_timers[id].period = period_ticks;
+	g_timers[id].mode = mode;
+	g_timers[id].callBackPtr = a_ptr;
+	g_timers[id].remaining = period_ticks;
+
+	SREG = sreg;
+	return TRUE;
+}
+
+void SWTIMER_stop(SWTIMER_Id id)
+{
+	if(id < SWTIMER_MAX_TIMERS)
+	{
+		/* One byte at a time is not atomic for a 16-bit value */
+		uint8 sreg = SREG;
+		cli();
+		g_timers[id].remaining = 0;
+		SREG = sreg;
+	}
+}
+
+boolean SWTIMER_isRunning(SWTIMER_Id id)
+{
+	boolean running = FALSE;
+	uint8 sreg;
+
+	if(id < SWTIMER_MAX_TIMERS)
+	{
+		sreg = SREG;
+		cli();
+		running = (g_timers[id].remaining != 0);
+		SREG = sreg;
+	}
+	return running;
+}
+
+uint32 SWTIMER_getTicks(void)
+{
+	uint32 ticks;
+	uint8 sreg;
+
+	/* The 4 bytes must be read without a tick in the middle */
+	sreg = SREG;
+	cli();
+	ticks = g_ticks;
+	SREG = sreg;
+
+	return ticks;
+}
+
+/*******************************************************************************
+*                       Private Functions Definitions                          *
+*******************************************************************************/
+static void SWTIMER_tick(void)
+{
+	SWTIMER_Id id;
+
+	g_ticks++;
+
+	for(id = 0; id < SWTIMER_MAX_TIMERS; id++)
+	{
+		if(g_timers[id].remaining != 0)
+		{
+			g_timers[id].remaining--;
+			if(g_timers[id].remaining == 0)
+			{
+				if(g_timers[id].mode == SWTIMER_PERIODIC)
+				{
+					g_timers[id].remaining = g_timers[id].period;
+				}
+
+				if(g_timers[id].callBackPtr != NULL_PTR)
+				{
+					(*g_timers[id].callBackPtr)();
+				}
+			}
+		}
+	}
+}
@@ -0,0 +1,83 @@
+/*
+ * Module: Software Timers
+ *
+ * File Name: swtimer.h
+ *
+ * Description: Header file for the software timers service, it runs many one-shot or periodic
+ *              timers with their own callbacks on one Timer1 compare interrupt (the tick).
+ *
+ *  Author: AS.Mahrous
+ */
+
+#ifndef MCAL_TIMER_SWTIMER_H_
+#define MCAL_TIMER_SWTIMER_H_
+
+#include "../std_types.h"
+#include "timer1.h"
+
+/*******************************************************************************
+ *                             Definitions                                     *
+ *******************************************************************************/
+/* Number of software timers, each timer is used by its ID from 0 to SWTIMER_MAX_TIMERS-1 */
+#define SWTIMER_MAX_TIMERS   8
+
+/* Tick period set by the Timer1 configurations given to SWTIMER_init */
+#define SWTIMER_TICK_MS      1
+
+/* Convert a time in milliseconds to ticks */
+#define SWTIMER_MS_TO_TICKS(ms)   ((ms) / SWTIMER_TICK_MS)
+
+/*******************************************************************************
+*                           Type Declarations                                  *
+*******************************************************************************/
+typedef uint8 SWTIMER_Id;
+
+typedef enum
+{
+	SWTIMER_ONE_SHOT,SWTIMER_PERIODIC
+}SWTIMER_Mode;
+
+/*******************************************************************************
+ *                      Functions Prototypes                                   *
+ *******************************************************************************/
+/*
+ * Description :
+ * Start Timer1 with the required configurations, every compare match is one tick.
+ * All the software timers are stopped.
+ */
+void SWTIMER_init(const TIMER1_configType * Config_Ptr);
+
+/*
+ * Description :
+ * Same as SWTIMER_init but the Timer1 configurations are in the program memory (PROGMEM).
+ */
+void SWTIMER_init_P(const TIMER1_configType * Config_Ptr);
+
+/*
+ * Description :
+ * Start (or restart) the software timer with the required period in ticks.
+ * The callback is called from the Timer1 ISR when the period ends, so it should be short,
+ * a one-shot timer is stopped before its callback is called and it can be started again from it.
+ * Return FALSE if the ID or the period is not valid.
+ */
+boolean SWTIMER_start(SWTIMER_Id id, uint16 period_ticks, SWTIMER_Mode mode, void(*a_ptr)(void));
+
+/*
+ * Description :
+ * Stop the software timer, its callback will not be called.
+ */
+void SWTIMER_stop(SWTIMER_Id id);
+
+/*
+ * Description :
+ * Return TRUE if the software timer is running.
+ */
+boolean SWTIMER_isRunning(SWTIMER_Id id);
+
+/*
+ * Description :
+ * Return the number of ticks since SWTIMER_init, it counts freely and wraps around after 2^32 ticks.
+ */
+uint32 SWTIMER_getTicks(void);
+
+#endif /* MCAL_TIMER_SWTIMER_H_ */
@@ -42,7 +42,6 @@ typedef struct
 	 TIMER1_Mode mode;
 } TIMER1_configType;
 
-TIMER1_configType TIMER1_settings;
 /*******************************************************************************
  *                      Functions Prototypes                                   *
  *******************************************************************************/
@@ -0,0 +1,391 @@
+/*
+ * uart.c
+ *
+ *  Created on: ١٢‏/٠٣‏/٢٠٢٤
+ *  Author: AS.Mahrous
+ */
+
+#include "uart.h"
+#include <avr/io.h>             /* To use the UART Registers */
+#include <avr/interrupt.h>      /* To use the UART ISRs */
+#include <avr/pgmspace.h>       /* To read the configurations and strings from the program memory */
+#include "../common_macros.h"   /* To use the macros like SET_BIT */
+
+#ifdef UART_INTERRUPT_MODE
+
+/*******************************************************************************
+ *                            Global Variables                                 *
+ *******************************************************************************/
+/*
+ * RX ring buffer: the RX ISR is the only writer of g_rxHead and the application
+ * is the only writer of g_rxTail, the buffer is empty when they are equal.
+ */
+static volatile uint8 g_rxBuffer[UART_RX_BUFFER_SIZE];
+static volatile uint8 g_rxHead = 0;
+static volatile uint8 g_rxTail = 0;
+
+/*
+ * TX ring buffer: the application is the only writer of g_txHead and the UDRE ISR
+ * is the only writer of g_txTail, the buffer is empty when they are equal.
+ */
+static volatile uint8 g_txBuffer[UART_TX_BUFFER_SIZE];
+static volatile uint8 g_txHead = 0;
+static volatile uint8 g_txTail = 0;
+
+/*******************************************************************************
+ *                                   ISRs                                      *
+ *******************************************************************************/
+ISR(USART_RXC_vect)
+{
+	/* Reading UDR clears the RXC flag, so it must be read even if the buffer is full */
+	uint8 data = UDR;
+	uint8 next_head = (uint8)((g_rxHead + 1) & (UART_RX_BUFFER_SIZE - 1));
+
+	/* If the buffer is full the new byte is dropped */
+	if(next_head != g_rxTail)
+	{
+		g_rxBuffer[g_rxHead] = data;
+		g_rxHead = next_head;
+	}
+}
+
+ISR(USART_UDRE_vect)
+{
+	if(g_txHead != g_txTail)
+	{
+		/* Put the next byte in UDR, it also clears the UDRE flag until it is moved to the shift register */
+		UDR = g_txBuffer[g_txTail];
+		g_txTail = (uint8)((g_txTail + 1) & (UART_TX_BUFFER_SIZE - 1));
+	}
+	else
+	{
+		/* Nothing left to send, disable the interrupt until new data is queued */
+		CLEAR_BIT(UCSRB,UDRIE);
+	}
+}
+
+#endif
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+/*
+ * Description :
+ * Functional responsible for Initialize the UART device by:
+ * 1. Setup the Frame format like number of data bits, parity bit type and number of stop bits.
+ * 2. Enable the UART.
+ * 3. Setup the UART baud rate.
+ */
+void UART_init(const UART_configType *Config_Ptr)
+{
+	uint16 ubrr_value = 0;
+
+	/* U2X = 1 for double transmission speed */
+	UCSRA = (1<<U2X);
+
+	/************************** UCSRB Description **************************
+	 * RXCIE = 1 Enable USART RX Complete Interrupt in interrupt mode only
+	 * TXCIE = 0 Disable USART Tx Complete Interrupt Enable
+	 * UDRIE = 0 Disable USART Data Register Empty Interrupt Enable,
+	 *         it is enabled only when there is data in the TX buffer
+	 * RXEN  = 1 Receiver Enable
+	 * RXEN  = 1 Transmitter Enable
+	 * UCSZ2 = 0 For 8-bit data mode
+	 * RXB8 & TXB8 not used for 8-bit data mode
+	 ***********************************************************************/
+#ifdef UART_INTERRUPT_MODE
+	/* Start with empty buffers */
+	g_rxHead = g_rxTail = 0;
+	g_txHead = g_txTail = 0;
+
+	UCSRB = (1<<RXCIE) | (1<<RXEN) | (1<<TXEN);
+#else
+	UCSRB = (1<<RXEN) | (1<<TXEN);
+#endif
+
+	/************************** UCSRC Description **************************
+	 * URSEL   = 1 The URSEL must be one when writing the UCSRC
+	 * UMSEL   = 0 Asynchronous Operation
+	 * UPM1:0  = based on the settings it will set the Parity Mode
+	 * USBS    = based on the settings it will set the No. Stop bits
+	 * UCSZ1:0 = based on the settings it will set the Data Bit Mode & UCSZ2 in UCSRB register
+	 * UCPOL   = 0 Used with the Synchronous operation only
+	 ***********************************************************************/
+	/* Selecting the no. of Stop Bits & Setting URSEL bit */
+	UCSRC = (1<<URSEL);
+	UCSRC = (UCSRC & 0xF9) | ((Config_Ptr->bit_data)<<1);
+	UCSRC = (UCSRC & 0xF7) | ((Config_Ptr->stop_bits)<<3);
+
+	/* Selecting The Parity Mode */
+	UCSRC = (UCSRC & 0xCF) | ((Config_Ptr->parity)<<4);
+
+	/* Another Method
+	switch(Config_Ptr -> parity)
+	{
+	case DISABLED:
+		CLEAR_BIT(UCSRC,UPM0);
+		CLEAR_BIT(UCSRC,UPM1);
+		break;
+
+	case EVEN_PARITY:
+		CLEAR_BIT(UCSRC,UPM0);
+		SET_BIT(UCSRC,UPM1);
+		break;
+
+	case ODD_PARITY:
+		SET_BIT(UCSRC,UPM0);
+		SET_BIT(UCSRC,UPM1);
+		break;
+	}
+	*/
+
+	/* Selecting The Data Bit Mode */
+
+	/* another method:
+	switch(Config_Ptr -> bit_data)
+	{
+	case FIVE_BIT:
+		CLEAR_BIT(UCSRC,UCSZ0);
+		CLEAR_BIT(UCSRC,UCSZ1);
+		CLEAR_BIT(UCSRB,UCSZ2);
+		break;
+
+	case SIX_BIT:
+		SET_BIT(UCSRC,UCSZ0);
+		CLEAR_BIT(UCSRC,UCSZ1);
+		CLEAR_BIT(UCSRB,UCSZ2);
+		break;
+
+	case SEVEN_BIT:
+		CLEAR_BIT(UCSRC,UCSZ0);
+		SET_BIT(UCSRC,UCSZ1);
+		CLEAR_BIT(UCSRB,UCSZ2);
+		break;
+
+	case EIGHT_BIT:
+		SET_BIT(UCSRC,UCSZ0);
+		SET_BIT(UCSRC,UCSZ1);
+		CLEAR_BIT(UCSRB,UCSZ2);
+		break;
+
+	case NINE_BIT:
+		SET_BIT(UCSRC,UCSZ0);
+		SET_BIT(UCSRC,UCSZ1);
+		SET_BIT(UCSRB,UCSZ2);
+		break;
+	} */
+
+	/* Calculate the UBRR register value */
+	ubrr_value = (uint16)(((F_CPU / ((Config_Ptr -> baud_rate) * 8UL))) - 1);
+
+	/* First 8 bits from the BAUD_PRESCALE inside UBRRL and last 4 bits in UBRRH*/
+	UBRRH = ubrr_value >> 8;
+	UBRRL = ubrr_value;
+}
+
+/*
+ * Description :
+ * Functional responsible for send byte to another UART device.
+ * In interrupt mode the byte is queued in the TX buffer, it only waits if the buffer is full.
+ */
+void UART_sendByte(const uint8 data)
+{
+#ifdef UART_INTERRUPT_MODE
+	/* Wait until there is a free place in the TX buffer */
+	while(UART_write(&data,1) == 0){}
+#else
+	/*
+	 * UDRE flag is set when the Tx buffer (UDR) is empty and ready for
+	 * transmitting a new byte so wait until this flag is set to one
+	 */
+	while(BIT_IS_CLEAR(UCSRA,UDRE)){}
+
+	/*
+	 * Put the required data in the UDR register and it also clear the UDRE flag as
+	 * the UDR register is not empty now
+	 */
+	UDR = data;
+
+	/************************* Another Method *************************
+	UDR = data;
+	while(BIT_IS_CLEAR(UCSRA,TXC)){} // Wait until the transmission is complete TXC = 1
+	SET_BIT(UCSRA,TXC); // Clear the TXC flag
+	*******************************************************************/
+#endif
+}
+
+/*
+ * Description :
+ * Functional responsible for receive byte from another UART device.
+ * It waits until a byte is received.
+ */
+uint8 UART_recieveByte(void)
+{
+#ifdef UART_INTERRUPT_MODE
+	uint8 data;
+
+	/* Wait until the RX ISR puts a byte in the RX buffer */
+	while(UART_tryReceive(&data) == FALSE){}
+
+	return data;
+#else
+	/* RXC flag is set when the UART receive data so wait until this flag is set to one */
+	while(BIT_IS_CLEAR(UCSRA,RXC)){}
+
+	/*
+	 * Read the received data from the Rx buffer (UDR)
+	 * The RXC flag will be cleared after read the data
+	 */
+    return UDR;
+#endif
+}
+
+/*
+ * Description :
+ * Take a received byte if there is one without waiting.
+ * Return TRUE if a byte is written in data, otherwise return FALSE.
+ */
+boolean UART_tryReceive(uint8 *data)
+{
+#ifdef UART_INTERRUPT_MODE
+	if(g_rxHead == g_rxTail)
+	{
+		return FALSE;
+	}
+
+	*data = g_rxBuffer[g_rxTail];
+
+	/* Free the place only after the byte is taken, so the ISR can't overwrite it */
+	g_rxTail = (uint8)((g_rxTail + 1) & (UART_RX_BUFFER_SIZE - 1));
+	return TRUE;
+#else
+	if(BIT_IS_CLEAR(UCSRA,RXC))
+	{
+		return FALSE;
+	}
+
+	*data = UDR;
+	return TRUE;
+#endif
+}
+
+/*
+ * Description :
+ * Queue the required bytes for sending without waiting.
+ * Return the number of bytes accepted, it can be less than size if there is no space for all of them.
+ */
+uint8 UART_write(const uint8 *data, uint8 size)
+{
+	uint8 count = 0;
+
+#ifdef UART_INTERRUPT_MODE
+	uint8 next_head;
+
+	while(count < size)
+	{
+		next_head = (uint8)((g_txHead + 1) & (UART_TX_BUFFER_SIZE - 1));
+
+		/* The buffer is full */
+		if(next_head == g_txTail)
+		{
+			break;
+		}
+
+		g_txBuffer[g_txHead] = data[count];
+		g_txHead = next_head;
+		count++;
+	}
+
+	if(count != 0)
+	{
+		/* The UDRE ISR will send the queued bytes one by one */
+		SET_BIT(UCSRB,UDRIE);
+	}
+#else
+	/* Without buffers only one byte can be accepted when UDR is empty */
+	if((size != 0) && BIT_IS_SET(UCSRA,UDRE))
+	{
+		UDR = data[0];
+		count = 1;
+	}
+#endif
+
+	return count;
+}
+
+/*
+ * Description :
+ * Return the number of received bytes waiting to be read.
+ */
+uint8 UART_available(void)
+{
+#ifdef UART_INTERRUPT_MODE
+	return (uint8)((g_rxHead - g_rxTail) & (UART_RX_BUFFER_SIZE - 1));
+#else
+	return BIT_IS_SET(UCSRA,RXC) ? 1 : 0;
+#endif
+}
+
+/*
+ * Description :
+ * Same as UART_init but the configurations are in the program memory (PROGMEM).
+ */
+void UART_init_P(const UART_configType *Config_Ptr)
+{
+	UART_configType config;
+
+	memcpy_P(&config, Config_Ptr, sizeof(config));
+	UART_init(&config);
+}
+
+/*
+ * Description :
+ * Send the required string through UART to the other UART device.
+ */
+void UART_sendString(const uint8 *Str)
+{
+	uint8 i = 0;
+	/* Send the whole string */
+	while(Str[i] != '\0')
+	{
+		UART_sendByte(Str[i]);
+		i++;
+	}
+}
+
+/*
+ * Description :
+ * Send the required string from the program memory (PROGMEM) through UART to the other UART device.
+ */
+void UART_sendString_P(const uint8 *Str)
+{
+	uint8 data;
+	/* Each character is read from the flash, the string is never copied to the RAM */
+	while((data = pgm_read_byte(Str)) != '\0')
+	{
+		UART_sendByte(data);
+		Str++;
+	}
+}
+
+/*
+ * Description :
+ * Receive the required string until the '#' symbol through UART from the other UART device.
+ */
+void UART_receiveString(uint8 *Str)
+{
+	uint8 i = 0;
+
+	/* Receive the first byte */
+	Str[i] = UART_recieveByte();
+
+	/* Receive the whole string until the '#' */
+	while(Str[i] != '#')
+	{
+		i++;
+		Str[i] = UART_recieveByte();
+	}
+
+	/* After receiving the whole string plus the '#', replace the '#' with '\0' */
+	Str[i] = '\0';
+}
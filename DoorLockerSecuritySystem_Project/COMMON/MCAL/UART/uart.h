@@ -15,6 +15,25 @@
  *******************************************************************************/
 #define UART_BAUD_RATE 9600
 
+/* to adjust the UART working mode, its either UART_POLLING_MODE or UART_INTERRUPT_MODE */
+#define UART_INTERRUPT_MODE
+
+#ifdef UART_INTERRUPT_MODE
+
+/* Sizes of the RX & TX ring buffers, each one should be a power of 2 and not more than 256 */
+#define UART_RX_BUFFER_SIZE 32
+#define UART_TX_BUFFER_SIZE 32
+
+#if((UART_RX_BUFFER_SIZE & (UART_RX_BUFFER_SIZE - 1)) || (UART_RX_BUFFER_SIZE > 256))
+#error "UART_RX_BUFFER_SIZE should be a power of 2 and not more than 256"
+#endif
+
+#if((UART_TX_BUFFER_SIZE & (UART_TX_BUFFER_SIZE - 1)) || (UART_TX_BUFFER_SIZE > 256))
+#error "UART_TX_BUFFER_SIZE should be a power of 2 and not more than 256"
+#endif
+
+#endif
+
 /*******************************************************************************
  *                          Type Declarations                                  *
  *******************************************************************************/
@@ -55,24 +74,58 @@ typedef struct
  */
 void UART_init(const UART_configType *Config_Ptr);
 
+/*
+ * Description :
+ * Same as UART_init but the configurations are in the program memory (PROGMEM).
+ */
+void UART_init_P(const UART_configType *Config_Ptr);
+
 /*
  * Description :
  * Functional responsible for send byte to another UART device.
+ * In interrupt mode the byte is queued in the TX buffer, it only waits if the buffer is full.
  */
 void UART_sendByte(const uint8 data);
 
 /*
  * Description :
  * Functional responsible for receive byte from another UART device.
+ * It waits until a byte is received.
  */
 uint8 UART_recieveByte(void);
 
+/*
+ * Description :
+ * Take a received byte if there is one without waiting.
+ * Return TRUE if a byte is written in data, otherwise return FALSE.
+ */
+boolean UART_tryReceive(uint8 *data);
+
+/*
+ * Description :
+ * Queue the required bytes for sending without waiting.
+ * Return the number of bytes accepted, it can be less than size if there is no space for all of them.
+ */
+uint8 UART_write(const uint8 *data, uint8 size);
+
+/*
+ * Description :
+ * Return the number of received bytes waiting to be read.
+ */
+uint8 UART_available(void);
+
 /*
  * Description :
  * Send the required string through UART to the other UART device.
  */
 void UART_sendString(const uint8 *Str);
 
+/*
+ * Description :
+ * Send the required string from the program memory (PROGMEM) through UART to the other UART device.
+ */
+void UART_sendString_P(const uint8 *Str);
+
 /*
  * Description :
  * Receive the required string until the '#' symbol through UART from the other UART device.
@@ -0,0 +1,257 @@
+ /******************************************************************************
+ *
+ * Module: PROTOCOL
+ *
+ * File Name: protocol.c
+ *
+ * Description: Source file for the framed UART protocol between HMI_ECU and CONTROL_ECU.
+ *              This file must be the same in both ECUs.
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#include "protocol.h"
+#include <util/delay.h>
+#include "../../MCAL/UART/uart.h"
+
+/*******************************************************************************
+ *                            Global Variables                                 *
+ *******************************************************************************/
+/* Sequence number of the last request sent by this ECU, 0 is never used */
+static uint8 g_requestSeq = 0;
+
+/*******************************************************************************
+ *                      Functions Definitions                                  *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Update the CRC-16/CCITT value with one more byte.
+ */
+uint16 PROTOCOL_crc16(uint16 crc, uint8 data)
+{
+	uint8 bit;
+
+	crc ^= (uint16)data << 8;
+	for(bit = 0; bit < 8; bit++)
+	{
+		if(crc & 0x8000)
+		{
+			crc = (crc << 1) ^ 0x1021;
+		}
+		else
+		{
+			crc <<= 1;
+		}
+	}
+	return crc;
+}
+
+/*
+ * Description :
+ * Build the line bytes of the frame in the buffer, the buffer size should be PROTOCOL_MAX_FRAME_SIZE.
+ * Return the number of bytes written in the buffer.
+ */
+uint8 PROTOCOL_encode(const PROTOCOL_Frame *frame, uint8 *buffer)
+{
+	uint8 i, size = 0;
+	uint16 crc = 0xFFFF;
+
+	buffer[size++] = PROTOCOL_START_BYTE;
+	buffer[size++] = frame->type;
+	buffer[size++] = frame->seq;
+	buffer[size++] = frame->length;
+	for(i = 0; i < frame->length; i++)
+	{
+		buffer[size++] = frame->payload[i];
+	}
+
+	/* The CRC covers everything after the start byte */
+	for(i = 1; i < size; i++)
+	{
+		crc = PROTOCOL_crc16(crc, buffer[i]);
+	}
+	buffer[size++] = (uint8)(crc >> 8);
+	buffer[size++] = (uint8)crc;
+
+	return size;
+}
+
+/*
+ * Description :
+ * Put the parser in its initial state waiting for a start byte.
+ */
+void PROTOCOL_parserReset(PROTOCOL_Parser *parser)
+{
+	parser->state = PROTOCOL_WAIT_START;
+	parser->index = 0;
+	parser->crc = 0xFFFF;
+}
+
+/*
+ * Description :
+ * Feed one received byte to the parser.
+ * Return TRUE when a complete frame with a correct CRC is in parser->frame.
+ * A frame with a wrong CRC or length is dropped and the parser waits for the next start byte.
+ */
+boolean PROTOCOL_parseByte(PROTOCOL_Parser *parser, uint8 data)
+{
+	switch(parser->state)
+	{
+	case PROTOCOL_WAIT_START:
+		/* Any byte outside a frame is ignored, this is how the two ECUs get in sync again */
+		if(data == PROTOCOL_START_BYTE)
+		{
+			PROTOCOL_parserReset(parser);
+			parser->state = PROTOCOL_WAIT_TYPE;
+		}
+		break;
+
+	case PROTOCOL_WAIT_TYPE:
+		parser->frame.type = data;
+		parser->crc = PROTOCOL_crc16(parser->crc, data);
+		parser->state = PROTOCOL_WAIT_SEQ;
+		break;
+
+	case PROTOCOL_WAIT_SEQ:
+		parser->frame.seq = data;
+		parser->crc = PROTOCOL_crc16(parser->crc, data);
+		parser->state = PROTOCOL_WAIT_LENGTH;
+		break;
+
+	case PROTOCOL_WAIT_LENGTH:
+		if(data > PROTOCOL_MAX_PAYLOAD)
+		{
+			/* Not a valid frame, wait for the next start byte */
+			parser->state = PROTOCOL_WAIT_START;
+			break;
+		}
+		parser->frame.length = data;
+		parser->crc = PROTOCOL_crc16(parser->crc, data);
+		parser->index = 0;
+		parser->state = (data == 0) ? PROTOCOL_WAIT_CRC_HIGH : PROTOCOL_WAIT_PAYLOAD;
+		break;
+
+	case PROTOCOL_WAIT_PAYLOAD:
+		parser->frame.payload[parser->index++] = data;
+		parser->crc = PROTOCOL_crc16(parser->crc, data);
+		if(parser->index == parser->frame.length)
+		{
+			parser->state = PROTOCOL_WAIT_CRC_HIGH;
+		}
+		break;
+
+	case PROTOCOL_WAIT_CRC_HIGH:
+		parser->received_crc = (uint16)data << 8;
+		parser->state = PROTOCOL_WAIT_CRC_LOW;
+		break;
+
+	case PROTOCOL_WAIT_CRC_LOW:
+		parser->received_crc |= data;
+		parser->state = PROTOCOL_WAIT_START;
+		if(parser->received_crc == parser->crc)
+		{
+			return TRUE;
+		}
+		break;
+	}
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Send the whole frame through the UART.
+ */
+void PROTOCOL_sendFrame(const PROTOCOL_Frame *frame)
+{
+	uint8 buffer[PROTOCOL_MAX_FRAME_SIZE];
+	uint8 size, sent = 0;
+
+	size = PROTOCOL_encode(frame, buffer);
+
+	/* It only waits if the frame is bigger than the free space in the UART TX buffer */
+	while(sent < size)
+	{
+		sent += UART_write(&buffer[sent], size - sent);
+	}
+}
+
+/*
+ * Description :
+ * Feed the bytes received by the UART to the parser without waiting.
+ * Return TRUE when a complete frame is in parser->frame.
+ */
+boolean PROTOCOL_receiveFrame(PROTOCOL_Parser *parser)
+{
+	uint8 data;
+
+	while(UART_tryReceive(&data))
+	{
+		if(PROTOCOL_parseByte(parser, data))
+		{
+			/* Leave the rest of the received bytes for the next call */
+			return TRUE;
+		}
+	}
+	return FALSE;
+}
+
+/*
+ * Description :
+ * Send the request once with a new sequence number without waiting for the reply.
+ */
+void PROTOCOL_sendRequest(PROTOCOL_Frame *request)
+{
+	/* A new sequence number lets the receiver tell a new request from a repeated one */
+	g_requestSeq++;
+	if(g_requestSeq == 0)
+	{
+		g_requestSeq = 1;
+	}
+	request->seq = g_requestSeq;
+
+	PROTOCOL_sendFrame(request);
+}
+
+/*
+ * Description :
+ * Send the request with a new sequence number and wait for the reply with the same sequence number,
+ * the request is sent again if the reply is not received within PROTOCOL_REPLY_TIMEOUT_MS.
+ * Return TRUE if the reply is received, or FALSE after PROTOCOL_MAX_ATTEMPTS tries.
+ */
+boolean PROTOCOL_request(PROTOCOL_Frame *request, PROTOCOL_Frame *reply)
+{
+	PROTOCOL_Parser parser;
+	uint8 attempt;
+	uint16 waited_ms;
+
+	PROTOCOL_parserReset(&parser);
+
+	for(attempt = 0; attempt < PROTOCOL_MAX_ATTEMPTS; attempt++)
+	{
+		if(attempt == 0)
+		{
+			PROTOCOL_sendRequest(request);
+		}
+		else
+		{
+			PROTOCOL_sendFrame(request);
+		}
+
+		for(waited_ms = 0; waited_ms < PROTOCOL_REPLY_TIMEOUT_MS; waited_ms++)
+		{
+			while(PROTOCOL_receiveFrame(&parser))
+			{
+				/* Replies to older requests are dropped */
+				if(parser.frame.seq == request->seq)
+				{
+					*reply = parser.frame;
+					return TRUE;
+				}
+			}
+			_delay_ms(1);
+		}
+	}
+	return FALSE;
+}
@@ -0,0 +1,142 @@
+ /******************************************************************************
+ *
+ * Module: PROTOCOL
+ *
+ * File Name: protocol.h
+ *
+ * Description: Header file for the framed UART protocol between HMI_ECU and CONTROL_ECU.
+ *              This file must be the same in both ECUs.
+ *
+ * Author: AS.Mahrous
+ *
+ *******************************************************************************/
+
+#ifndef PROTOCOL_H_
+#define PROTOCOL_H_
+
+#include "../../MCAL/std_types.h"
+
+/*******************************************************************************
+ *                                Definitions                                  *
+ *******************************************************************************/
+/* Frame layout on the line:
+ * | START | TYPE | SEQ | LENGTH | PAYLOAD (LENGTH bytes) | CRC high | CRC low |
+ * The CRC is CRC-16/CCITT (0x1021, initial value 0xFFFF) over TYPE, SEQ, LENGTH and PAYLOAD.
+ */
+#define PROTOCOL_START_BYTE         0x7E
+#define PROTOCOL_MAX_PAYLOAD        16
+#define PROTOCOL_HEADER_SIZE        4      /* START + TYPE + SEQ + LENGTH */
+#define PROTOCOL_CRC_SIZE           2
+#define PROTOCOL_MAX_FRAME_SIZE     (PROTOCOL_HEADER_SIZE + PROTOCOL_MAX_PAYLOAD + PROTOCOL_CRC_SIZE)
+
+/* How long the requester waits for the reply of a frame before sending it again */
+#define PROTOCOL_REPLY_TIMEOUT_MS   250
+#define PROTOCOL_MAX_ATTEMPTS       4
+
+/*******************************************************************************
+ *                               Types Declaration                             *
+ *******************************************************************************/
+typedef enum
+{
+	/* CONTROL_ECU -> HMI_ECU */
+	PROTOCOL_MSG_ACK = 0x01,         /* The request is done, payload[0] holds the result */
+	PROTOCOL_MSG_NACK = 0x02,        /* The request type or its payload is not valid */
+
+	/* HMI_ECU -> CONTROL_ECU */
+	PROTOCOL_MSG_CREATE_PASS = 0x10, /* payload: the new password followed by its re-entered copy */
+	PROTOCOL_MSG_CHECK_PASS = 0x11,  /* payload: the entered password */
+	PROTOCOL_MSG_OPEN_DOOR = 0x12,   /* no payload */
+	PROTOCOL_MSG_ALARM = 0x13,       /* no payload */
+	PROTOCOL_MSG_GET_STATUS = 0x14,  /* no payload, reply payload: PROTOCOL_DoorState then 1 if the alarm is ON */
+	PROTOCOL_MSG_STOP = 0x15         /* no payload, emergency stop of the door motor and the alarm */
+}PROTOCOL_MsgType;
+
+/* Door states reported in the reply of PROTOCOL_MSG_GET_STATUS */
+typedef enum
+{
+	PROTOCOL_DOOR_LOCKED,PROTOCOL_DOOR_UNLOCKING,PROTOCOL_DOOR_OPEN,PROTOCOL_DOOR_LOCKING,PROTOCOL_DOOR_STOPPED
+}PROTOCOL_DoorState;
+
+typedef struct
+{
+	uint8 type;
+	uint8 seq;
+	uint8 length;
+	uint8 payload[PROTOCOL_MAX_PAYLOAD];
+}PROTOCOL_Frame;
+
+typedef enum
+{
+	PROTOCOL_WAIT_START,PROTOCOL_WAIT_TYPE,PROTOCOL_WAIT_SEQ,PROTOCOL_WAIT_LENGTH,
+	PROTOCOL_WAIT_PAYLOAD,PROTOCOL_WAIT_CRC_HIGH,PROTOCOL_WAIT_CRC_LOW
+}PROTOCOL_ParserState;
+
+typedef struct
+{
+	PROTOCOL_ParserState state;
+	uint8 index;
+	uint16 crc;
+	uint16 received_crc;
+	PROTOCOL_Frame frame;
+}PROTOCOL_Parser;
+
+/*******************************************************************************
+ *                              Functions Prototypes                           *
+ *******************************************************************************/
+
+/*
+ * Description :
+ * Update the CRC-16/CCITT value with one more byte.
+ */
+uint16 PROTOCOL_crc16(uint16 crc, uint8 data);
+
+/*
+ * Description :
+ * Build the line bytes of the frame in the buffer, the buffer size should be PROTOCOL_MAX_FRAME_SIZE.
+ * Return the number of bytes written in the buffer.
+ */
+uint8 PROTOCOL_encode(const PROTOCOL_Frame *frame, uint8 *buffer);
+
+/*
+ * Description :
+ * Put the parser in its initial state waiting for a start byte.
+ */
+void PROTOCOL_parserReset(PROTOCOL_Parser *parser);
+
+/*
+ * Description :
+ * Feed one received byte to the parser.
+ * Return TRUE when a complete frame with a correct CRC is in parser->frame.
+ * A frame with a wrong CRC or length is dropped and the parser waits for the next start byte.
+ */
+boolean PROTOCOL_parseByte(PROTOCOL_Parser *parser, uint8 data);
+
+/*
+ * Description :
+ * Send the whole frame through the UART.
+ */
+void PROTOCOL_sendFrame(const PROTOCOL_Frame *frame);
+
+/*
+ * Description :
+ * Feed the bytes received by the UART to the parser without waiting.
+ * Return TRUE when a complete frame is in parser->frame.
+ */
+boolean PROTOCOL_receiveFrame(PROTOCOL_Parser *parser);
+
+/*
+ * Description :
+ * Send the request once with a new sequence number without waiting for the reply,
+ * the caller watches for the reply with PROTOCOL_receiveFrame and sends it again with PROTOCOL_sendFrame.
+ */
+void PROTOCOL_sendRequest(PROTOCOL_Frame *request);
+
+/*
+ * Description :
+ * Send the request with a new sequence number and wait for the reply with the same sequence number,
+ * the request is sent again if the reply is not received within PROTOCOL_REPLY_TIMEOUT_MS.
+ * Return TRUE if the reply is received, or FALSE after PROTOCOL_MAX_ATTEMPTS tries.
+ */
+boolean PROTOCOL_request(PROTOCOL_Frame *request, PROTOCOL_Frame *reply);
+
+#endif /* PROTOCOL_H_ */
@@ -4,7 +4,7 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../MCAL/I2C/i2c.c 
+../../COMMON/MCAL/I2C/i2c.c 
 
 OBJS += \
 ./MCAL/I2C/i2c.o 
@@ -14,7 +14,7 @@ C_DEPS += \
 
 
 # Each subdirectory must supply rules for building sources it contributes
-MCAL/I2C/%.o: ../MCAL/I2C/%.c MCAL/I2C/subdir.mk
+MCAL/I2C/%.o: ../../COMMON/MCAL/I2C/%.c MCAL/I2C/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
 	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
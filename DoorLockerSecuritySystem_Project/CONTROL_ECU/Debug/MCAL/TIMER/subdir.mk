@@ -4,17 +4,20 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../MCAL/TIMER/timer1.c 
+../../COMMON/MCAL/TIMER/swtimer.c \
+../../COMMON/MCAL/TIMER/timer1.c 
 
 OBJS += \
+./MCAL/TIMER/swtimer.o \
 ./MCAL/TIMER/timer1.o 
 
 C_DEPS += \
+./MCAL/TIMER/swtimer.d \
 ./MCAL/TIMER/timer1.d 
 
 
 # Each subdirectory must supply rules for building sources it contributes
-MCAL/TIMER/%.o: ../MCAL/TIMER/%.c MCAL/TIMER/subdir.mk
+MCAL/TIMER/%.o: ../../COMMON/MCAL/TIMER/%.c MCAL/TIMER/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
 	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
@@ -27,5 +27,6 @@ MCAL/GPIO \
 MCAL/I2C \
 MCAL/TIMER \
 MCAL/UART \
+SERVICE/PROTOCOL \
 . \
 
@@ -11,13 +11,16 @@
  */
 
 #include <avr/io.h>
+#include <avr/pgmspace.h>   /* To keep the strings and the configurations in the program memory */
 #include "util/delay.h"
-#include "MCAL/I2C/i2c.h"
-#include "MCAL/UART/uart.h"
-#include "HAL/BUZZER/buzzer.h"
-#include "HAL/EEPROM/eeprom.h"
-#include "HAL/DC_Motor/dc_motor.h"
-#include "MCAL/TIMER/timer1.h"
+#include "../COMMON/MCAL/I2C/i2c.h"
+#include "../COMMON/MCAL/UART/uart.h"
+#include "../COMMON/HAL/BUZZER/buzzer.h"
+#include "../COMMON/HAL/EEPROM/eeprom.h"
+#include "../COMMON/HAL/DC_Motor/dc_motor.h"
+#include "../COMMON/MCAL/TIMER/timer1.h"
+#include "../COMMON/MCAL/TIMER/swtimer.h"
+#include "../COMMON/SERVICE/PROTOCOL/protocol.h"
 
 /*******************************************************************************
 *                              Definitions                                     *
@@ -26,10 +29,39 @@
 #define UNMATCHED 0
 #define PASSWORD_SIZE 5
 
+/* EEPROM address of the first digit of the saved password */
+#define PASSWORD_EEPROM_ADDRESS 0x01
+
+/* Software timers used by the door and alarm sequences */
+#define DOOR_TIMER_ID  0
+#define ALARM_TIMER_ID 1
+
+/* Door and alarm sequences times */
+#define DOOR_UNLOCKING_TIME_MS  15000
+#define DOOR_HOLD_TIME_MS       3000
+#define DOOR_LOCKING_TIME_MS    15000
+#define ALARM_TIME_MS           60000
+
 /*******************************************************************************
 *                            Variable Definitions                              *
 *******************************************************************************/
-volatile uint8 g_tickTime = 0;
+/* RAM copy of the password saved in the EEPROM, every check is done against it */
+uint8 g_savedPassword[PASSWORD_SIZE];
+
+/* The last handled request and its reply, to answer a repeated request without doing it again */
+uint8 g_lastRequestType = 0;
+uint8 g_lastRequestSeq = 0;
+PROTOCOL_Frame g_lastReply;
+
+/* State of the door sequence */
+PROTOCOL_DoorState g_doorState = PROTOCOL_DOOR_LOCKED;
+
+/* TRUE while the alarm is ON */
+boolean g_alarmOn = FALSE;
+
+/* Set by the software timers callbacks when the time of the current step ends */
+volatile boolean g_doorTimeout = FALSE;
+volatile boolean g_alarmTimeout = FALSE;
 
 /*******************************************************************************
 *                            Types Definitions                                 *
@@ -38,170 +70,269 @@ volatile uint8 g_tickTime = 0;
  * address: device address 10
  * bit-rate: 400000 kbps
  */
-TWI_ConfigType I2C_settings={0x0A,I2C_BAUD_RATE_400K};
+const TWI_ConfigType I2C_settings PROGMEM = {0x0A,I2C_BAUD_RATE_400K};
 
 /* Setting the UART configurations */
-UART_configType UART_settings_mc2 = {EIGHT_BIT,EVEN_PARITY,ONE_STOP_BIT,UART_BAUD_RATE};
+const UART_configType UART_settings_mc2 PROGMEM = {EIGHT_BIT,EVEN_PARITY,ONE_STOP_BIT,UART_BAUD_RATE};
 
 /* How the Timer Settings has been Chosen:
  * CPU Frequency (F_CPU) = 8 MHz
- * Prescaler = F_CPU/256
- * With a prescaler of 256, the effective clock frequency for Timer1 becomes:
+ * Prescaler = F_CPU/64
+ * With a prescaler of 64, the effective clock frequency for Timer1 becomes:
  * Effective Frequency = F_CPU / Prescaler
- *                     = 8 MHz / 256 = 31250 Hz
+ *                     = 8 MHz / 64 = 125000 Hz
  * Timer Ticks = Timer Frequency * Time
- *             = 31250 * 1 = 31250
+ *             = 125000 * 0.001 = 125
  * Compare value = Timer Ticks - 1
- *               = 31250 - 1 = 31249
- * So, with a compare value of 31249, it means that the Timer1 will overflow exactly once every second. */
+ *               = 125 - 1 = 124
+ * So, with a compare value of 124, the Timer1 compare match happens exactly once every millisecond,
+ * this is the tick of the software timers (SWTIMER_TICK_MS). */
 
  /* Setting the TIMER configurations. */
-TIMER1_configType TIMER1_settings_2 = {0,31249,F_CPU_256,CTC_OCR1A_TOP};
+const TIMER1_configType TIMER1_settings_2 PROGMEM = {0,124,F_CPU_64,CTC_OCR1A_TOP};
 
 /*******************************************************************************
 *                           Functions Definitions                              *
 *******************************************************************************/
 /* Description:
- *  * It is the callback function and it increments the ticks of the timer.
+ * It compares two passwords digit by digit.
+ * All the digits are compared even after a mismatch, so the time taken doesn't depend on the entered digits.
  */
-void Timer1_callBack(void)
+uint8 compare_Passwords(const uint8 *password_1, const uint8 *password_2)
 {
-	g_tickTime++;
-}
-
-/* Description:
- * It receives the re-Entered Password from HMI_ECU & saves it in the EEPROM.
- * It also checks whether the received Password matches the saved one or not.
- */
-void Password_Checker(void)
-{
-	uint8 idx=0,check_counter=0,received_key=0,save_key=0,saved_1=0,saved_2=0;
+	uint8 idx=0,check_counter=0;
 
-	/* This loop is to Receive & Save the re-Entered Password */
-	for (idx = 6; idx < PASSWORD_SIZE+6 ; idx++)
-	{
-
-		received_key = UART_recieveByte();					       /* Receive the key from HMI_ECU */
-		save_key = EEPROM_writeByte((0x01) + idx, received_key);   /* Save the key in the EEPROM */
-
-		_delay_ms(500);								 /* delay to give the EEPROM the time to save successfully */
-	}
-
-	/* checking the two received passwords byte by byte */
 	for (idx = 0;idx < PASSWORD_SIZE; idx++)
 	{
-		EEPROM_readByte((0x01) + idx, &saved_1);
-		_delay_ms(10);
-		EEPROM_readByte((0x07) + idx, &saved_2);
-		_delay_ms(10);
-		if (saved_1 == saved_2)
+		if (password_1[idx] == password_2[idx])
 		{
-			check_counter++;       /* If the two bytes are matched the check counter will be incremented */
+			check_counter++;       /* If the two digits are matched the check counter will be incremented */
 		}
 	}
 	if (check_counter == PASSWORD_SIZE)
 	{
-		UART_sendByte(MATCHED);   /* Sending 1 to HMI_ECU to let it know that the two passwords are matched */
+		return MATCHED;
 	}
 	else
 	{
-		UART_sendByte(UNMATCHED); /* Sending 0 to HMI_ECU to let it know that the two passwords are not matched */
+		return UNMATCHED;
 	}
-	check_counter = 0;            /* reset the check counter for another check */
 }
 
 /* Description:
- * It receives the Password for the 1st time or when changing it from HMI_ECU & saves it in the EEPROM.
- * It also checks whether the received Passwords are matched or not.
+ * It reads the saved password from the EEPROM into its RAM copy.
  */
-void createPass_changePass(void)
+void load_Password(void)
 {
-	uint8 idx=0,check_counter=0,received_key=0,save_key=0,saved_1=0,saved_2=0;
+	/* the whole password is read in one sequential read */
+	EEPROM_readBlock(PASSWORD_EEPROM_ADDRESS, g_savedPassword, PASSWORD_SIZE);
+}
 
-	/* This loop is to Receive & Save the 1st Entered Password */
-	for (idx = 0; idx < PASSWORD_SIZE ; idx++)
-	{
+/* Description:
+ * It checks whether the Password received from HMI_ECU matches the saved one or not.
+ * The check is done against the RAM copy, so nothing is written to the EEPROM.
+ */
+uint8 Password_Checker(const uint8 *password)
+{
+	/* let HMI_ECU know whether the two passwords are matched or not */
+	return compare_Passwords(password, g_savedPassword);
+}
+
+/* Description:
+ * It receives the Password for the 1st time or when changing it from HMI_ECU.
+ * The frame holds the Password followed by the re-Entered one, and it is saved
+ * in the EEPROM only if the two are matched.
+ */
+uint8 createPass_changePass(const uint8 *passwords)
+{
+	uint8 idx=0;
 
-		received_key = UART_recieveByte();					       /* Receive the key from HMI_ECU */
-		save_key = EEPROM_writeByte((0x01) + idx, received_key);   /* Save the key in the EEPROM */
+	if (compare_Passwords(passwords, &passwords[PASSWORD_SIZE]) == UNMATCHED)
+	{
+		return UNMATCHED;          /* the saved password is kept as it is */
+	}
 
-		_delay_ms(500);								 /* delay to give the EEPROM the time to save successfully */
+	/* Save the new Password in one page write */
+	if (EEPROM_writeBlock(PASSWORD_EEPROM_ADDRESS, passwords, PASSWORD_SIZE) == ERROR)
+	{
+		return UNMATCHED;          /* the new password is not saved */
 	}
 
-	/* This loop is to Receive & Save the re-Entered Password */
-	for (idx = 6; idx < PASSWORD_SIZE+6 ; idx++)
+	for (idx = 0; idx < PASSWORD_SIZE ; idx++)
 	{
+		g_savedPassword[idx] = passwords[idx];
+	}
+
+	return MATCHED;                /* let HMI_ECU know that the two passwords are matched */
+}
 
-		received_key = UART_recieveByte();					       /* Receive the key from HMI_ECU */
-		save_key = EEPROM_writeByte((0x01) + idx, received_key);   /* Save the key in another place in EEPROM */
+/* Description:
+ * It sends the reply of the received request to HMI_ECU with the same sequence number
+ * and keeps it in case the same request is received again.
+ */
+void send_ReplyData(const PROTOCOL_Frame *request, uint8 type, const uint8 *data, uint8 length)
+{
+	uint8 idx;
 
-		_delay_ms(500);								 /* delay to give the EEPROM the time to save successfully */
+	g_lastReply.type = type;
+	g_lastReply.seq = request->seq;
+	g_lastReply.length = length;
+	for (idx = 0; idx < length; idx++)
+	{
+		g_lastReply.payload[idx] = data[idx];
 	}
 
-	/* checking the two received passwords byte by byte */
-	for (idx = 0;idx < PASSWORD_SIZE; idx++)
+	g_lastRequestType = request->type;
+	g_lastRequestSeq = request->seq;
+
+	PROTOCOL_sendFrame(&g_lastReply);
+}
+
+/* Description:
+ * It sends a reply with a one byte result.
+ */
+void send_Reply(const PROTOCOL_Frame *request, uint8 type, uint8 result)
+{
+	send_ReplyData(request, type, &result, 1);
+}
+
+/* Description:
+ * Callbacks of the door and alarm software timers, they are called from the Timer1 ISR
+ * so they only let the main loop know that the current step ended.
+ */
+void door_TimerCallBack(void)
+{
+	g_doorTimeout = TRUE;
+}
+
+void alarm_TimerCallBack(void)
+{
+	g_alarmTimeout = TRUE;
+}
+
+/* Description:
+ * It starts the door sequence: unlocking for 15 seconds, open for 3 seconds then locking for 15 seconds.
+ * It returns immediately, the sequence goes on in door_Update.
+ */
+void door_Open(void)
+{
+	/* The door is already moving */
+	if ((g_doorState != PROTOCOL_DOOR_LOCKED) && (g_doorState != PROTOCOL_DOOR_STOPPED))
 	{
-		EEPROM_readByte((0x01) + idx, &saved_1);
-		_delay_ms(10);
-		EEPROM_readByte((0x07) + idx, &saved_2);
-		_delay_ms(10);
-		if (saved_1 == saved_2)
-		{
-			check_counter++;       /* If the two bytes are matched the check counter will be incremented */
-		}
+		return;
 	}
-	if (check_counter == PASSWORD_SIZE)
+
+	/* OPEN the door for 15 seconds */
+	g_doorTimeout = FALSE;
+	DcMotor_Rotate(CW, MAX_SPEED);
+	g_doorState = PROTOCOL_DOOR_UNLOCKING;
+	SWTIMER_start(DOOR_TIMER_ID, SWTIMER_MS_TO_TICKS(DOOR_UNLOCKING_TIME_MS), SWTIMER_ONE_SHOT, door_TimerCallBack);
+}
+
+/* Description:
+ * It moves the door sequence to its next step when the time of the current step ends.
+ */
+void door_Update(void)
+{
+	if (g_doorTimeout == FALSE)
 	{
-		UART_sendByte(MATCHED);   /* Sending 1 to HMI_ECU to let it know that the two passwords are matched */
+		return;
 	}
-	else
+	g_doorTimeout = FALSE;
+
+	switch (g_doorState)
 	{
-		UART_sendByte(UNMATCHED); /* Sending 0 to HMI_ECU to let it know that the two passwords are not matched */
+	case PROTOCOL_DOOR_UNLOCKING:
+		/* HOLD the door for 3 seconds */
+		DcMotor_Rotate(STOP, 0);
+		g_doorState = PROTOCOL_DOOR_OPEN;
+		SWTIMER_start(DOOR_TIMER_ID, SWTIMER_MS_TO_TICKS(DOOR_HOLD_TIME_MS), SWTIMER_ONE_SHOT, door_TimerCallBack);
+		break;
+
+	case PROTOCOL_DOOR_OPEN:
+		/* CLOSE the door for 15 seconds */
+		DcMotor_Rotate(A_CW, MAX_SPEED);
+		g_doorState = PROTOCOL_DOOR_LOCKING;
+		SWTIMER_start(DOOR_TIMER_ID, SWTIMER_MS_TO_TICKS(DOOR_LOCKING_TIME_MS), SWTIMER_ONE_SHOT, door_TimerCallBack);
+		break;
+
+	case PROTOCOL_DOOR_LOCKING:
+		DcMotor_Rotate(STOP, 0);                /* Stopping the motor */
+		g_doorState = PROTOCOL_DOOR_LOCKED;
+		break;
+
+	default:
+		break;
 	}
-	check_counter = 0;            /* reset the check counter for another check */
 }
 
-void timer1_Delay(uint8 sec)
+/* Description:
+ * It activates the BUZZER for 1 minute, it returns immediately and alarm_Update turns it off.
+ */
+void alarm_Start(void)
 {
-    /* Timer1 initialization */
-    TIMER1_init(&TIMER1_settings_2);
+	g_alarmTimeout = FALSE;
+	Buzzer_on();
+	g_alarmOn = TRUE;
+	SWTIMER_start(ALARM_TIMER_ID, SWTIMER_MS_TO_TICKS(ALARM_TIME_MS), SWTIMER_ONE_SHOT, alarm_TimerCallBack);
+}
 
-	/* Setting the TIMER1_callBack to be the callback function */
-	TIMER1_setCallBack(Timer1_callBack);
+/* Description:
+ * It turns off the BUZZER after 1 minute.
+ */
+void alarm_Update(void)
+{
+	if (g_alarmTimeout == FALSE)
+	{
+		return;
+	}
+	g_alarmTimeout = FALSE;
 
-	/* reset the timer counter to start counting from 0 */
-	g_tickTime = 0;
+	Buzzer_off();
+	g_alarmOn = FALSE;
+}
 
-	/* wait until the input seconds */
-	while (g_tickTime <= sec);
+/* Description:
+ * Emergency stop: the motor and the BUZZER are stopped immediately.
+ */
+void emergency_Stop(void)
+{
+	SWTIMER_stop(DOOR_TIMER_ID);
+	SWTIMER_stop(ALARM_TIMER_ID);
+	g_doorTimeout = FALSE;
+	g_alarmTimeout = FALSE;
 
-	TIMER1_deInit();
+	DcMotor_Rotate(STOP, 0);
+	if (g_doorState != PROTOCOL_DOOR_LOCKED)
+	{
+		g_doorState = PROTOCOL_DOOR_STOPPED;
+	}
 
-	/* reset the timer counter again to get the needed seconds */
-	g_tickTime = 0;
+	Buzzer_off();
+	g_alarmOn = FALSE;
 }
+
 /*******************************************************************************
 *                              Main Code                                       *
 *******************************************************************************/
 int main(void)
 {
-	/* Variable to receive the sent data from HMI_ECU */
-	uint8 hmi_received_data = 0;
+	/* Parser of the frames received from HMI_ECU */
+	PROTOCOL_Parser parser;
+	PROTOCOL_Frame *request = &parser.frame;
+	uint8 status[2];
 
     /* enabling interrupt bit "I-bit" */
     SREG |= (1<<7);
 
 	/* I2C initialization */
-	TWI_init(&I2C_settings);
+	TWI_init_P(&I2C_settings);
 
 	/* UART initialization */
-	UART_init(&UART_settings_mc2);
-
-	 /* TIMER initialization */
-	TIMER1_init(&TIMER1_settings_2);
+	UART_init_P(&UART_settings_mc2);
 
-	/* Setting the TIMER1_callBack to be the callback function */
-	TIMER1_setCallBack(Timer1_callBack);
+	/* Software timers initialization, Timer1 gives them a tick every millisecond */
+	SWTIMER_init_P(&TIMER1_settings_2);
 
 	/* Initializing the DC-MOTOR */
 	DcMotor_init();
@@ -209,59 +340,82 @@ int main(void)
 	/* Initializing the BUZZER */
 	Buzzer_init();
 
+	/* Keep a RAM copy of the saved password for checking */
+	load_Password();
+
+	PROTOCOL_parserReset(&parser);
+
 	for(;;)
 	{
-		hmi_received_data = UART_recieveByte();
+		/* The door and alarm sequences go on while the requests are answered */
+		door_Update();
+		alarm_Update();
+
+		if (PROTOCOL_receiveFrame(&parser) == FALSE)
+		{
+			continue;
+		}
+
+		/* The reply of the last request was lost, so send it again without doing the request again */
+		if ((request->seq == g_lastRequestSeq) && (request->type == g_lastRequestType))
+		{
+			PROTOCOL_sendFrame(&g_lastReply);
+			continue;
+		}
 
-		switch(hmi_received_data)
+		switch(request->type)
 		{
-		case '*': /* The user will change the password or enter the password for the 1st time */
+		case PROTOCOL_MSG_CREATE_PASS: /* The user will change the password or enter the password for the 1st time */
 
+			if (request->length != 2 * PASSWORD_SIZE)
+			{
+				send_Reply(request, PROTOCOL_MSG_NACK, 0);
+				break;
+			}
 			/* call createPass_changePass function to do this action */
-			createPass_changePass();
+			send_Reply(request, PROTOCOL_MSG_ACK, createPass_changePass(request->payload));
 
 			break;
 
-		case '#': /* The user will re-Enter the password to either open the door or change password */
+		case PROTOCOL_MSG_CHECK_PASS: /* The user will re-Enter the password to either open the door or change password */
 
-			/* call PASS_CHECK function to check whether the password entered matches the user's password or not */
-			Password_Checker();
+			if (request->length != PASSWORD_SIZE)
+			{
+				send_Reply(request, PROTOCOL_MSG_NACK, 0);
+				break;
+			}
+			/* call Password_Checker function to check whether the password entered matches the user's password or not */
+			send_Reply(request, PROTOCOL_MSG_ACK, Password_Checker(request->payload));
 
 			break;
 
-		case '&': /* The user wants to open the door */
-
-			/* OPEN the door for 15 seconds */
-			DcMotor_Rotate(CW, MAX_SPEED);
-			/* Delay with using timer1 */
-			timer1_Delay(15);
+		case PROTOCOL_MSG_OPEN_DOOR: /* The user wants to open the door */
 
-			/* HOLD the door for 3 seconds */
-			DcMotor_Rotate(STOP, 0);
-			/* Delay with using timer1 */
-			timer1_Delay(3);
+			send_Reply(request, PROTOCOL_MSG_ACK, 0);
+			door_Open();
+			break;
 
-			/* CLOSE the door for 15 seconds */
-			DcMotor_Rotate(A_CW, MAX_SPEED);
-			/* Delay with using timer1 */
-			timer1_Delay(15);
+		case PROTOCOL_MSG_ALARM: /* The user entered the wrong password 3-times ,so the Alarm must be ON */
 
-			g_tickTime = 0;                         /* reset the timer counter */
-			DcMotor_Rotate(STOP, 0);                /* Stopping the motor */
+			send_Reply(request, PROTOCOL_MSG_ACK, 0);
+			alarm_Start();
 			break;
 
-		case '$': /* The user entered the wrong password 3-times ,so the Alarm must be ON */
+		case PROTOCOL_MSG_GET_STATUS:
 
-			g_tickTime = 0;
-			/* Activate the BUZZER for 1 minute */
-			Buzzer_on();
-			/* Delay with using timer1 */
-			timer1_Delay(60);
+			status[0] = g_doorState;
+			status[1] = g_alarmOn;
+			send_ReplyData(request, PROTOCOL_MSG_ACK, status, 2);
+			break;
+
+		case PROTOCOL_MSG_STOP:
 
-			g_tickTime = 0;
-			/* Turn off the BUZZER after 1 minute */
-			Buzzer_off();
+			emergency_Stop();
+			send_Reply(request, PROTOCOL_MSG_ACK, 0);
+			break;
 
+		default:
+			send_Reply(request, PROTOCOL_MSG_NACK, 0);
 			break;
 		}
 	}
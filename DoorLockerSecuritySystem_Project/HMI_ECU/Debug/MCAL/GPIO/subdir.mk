@@ -4,7 +4,7 @@
 
 # Add inputs and outputs from these tool invocations to the build variables 
 C_SRCS += \
-../MCAL/GPIO/gpio.c 
+../../COMMON/MCAL/GPIO/gpio.c 
 
 OBJS += \
 ./MCAL/GPIO/gpio.o 
@@ -14,7 +14,7 @@ C_DEPS += \
 
 
 # Each subdirectory must supply rules for building sources it contributes
-MCAL/GPIO/%.o: ../MCAL/GPIO/%.c MCAL/GPIO/subdir.mk
+MCAL/GPIO/%.o: ../../COMMON/MCAL/GPIO/%.c MCAL/GPIO/subdir.mk
 	@echo 'Building file: $<'
 	@echo 'Invoking: AVR Compiler'
 	avr-gcc -Wall -g2 -gstabs -O0 -fpack-struct -fshort-enums -ffunction-sections -fdata-sections -std=gnu99 -funsigned-char -funsigned-bitfields -mmcu=atmega32 -DF_CPU=8000000UL -MMD -MP -MF"$(@:%.o=%.d)" -MT"$@" -c -o "$@" "$<"
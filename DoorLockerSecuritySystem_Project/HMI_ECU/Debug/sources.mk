@@ -24,5 +24,6 @@ HAL/LCD \
 MCAL/GPIO \
 MCAL/TIMER \
 MCAL/UART \
+SERVICE/PROTOCOL \
 . \
 
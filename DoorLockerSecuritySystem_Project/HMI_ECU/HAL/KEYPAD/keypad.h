@@ -1,49 +0,0 @@
- /******************************************************************************
- *
- * Module: KEYPAD
- *
- * File Name: keypad.h
- *
- * Description: Header file for the Keypad driver
- *
- * Author: AS.Mahrous
- *
- *******************************************************************************/
-
-#ifndef KEYPAD_H_
-#define KEYPAD_H_
-
-#include "../../MCAL/std_types.h"
-
-/*******************************************************************************
- *                                Definitions                                  *
- *******************************************************************************/
-
-/* Keypad configurations for number of rows and columns */
-#define KEYPAD_NUM_COLS                   4
-#define KEYPAD_NUM_ROWS                   4
-
-/* Keypad Port Configurations */
-#define KEYPAD_ROW_PORT_ID                PORTB_ID
-#define KEYPAD_FIRST_ROW_PIN_ID           PIN4_ID
-
-#define KEYPAD_COL_PORT_ID                PORTC_ID
-#define KEYPAD_FIRST_COL_PIN_ID           PIN4_ID
-
-/* Keypad button logic configurations */
-#define KEYPAD_BUTTON_PRESSED            LOGIC_LOW
-#define KEYPAD_BUTTON_RELEASED           LOGIC_HIGH
-
-/* Choosing the Keypad Enter button */
-#define KEYPAD_ENTER_KEY '%'
-/*******************************************************************************
- *                      Functions Prototypes                                   *
- *******************************************************************************/
-
-/*
- * Description :
- * Get the Keypad pressed button
- */
-uint8 KEYPAD_getPressedKey(void);
-
-#endif /* KEYPAD_H_ */
@@ -10,11 +10,13 @@
  */
 
 #include <avr/io.h>
-#include "util/delay.h"
-#include "HAL/LCD/lcd.h"
-#include "MCAL/UART/uart.h"
-#include "HAL/KEYPAD/keypad.h"
-#include "MCAL/TIMER/timer1.h"
+#include <avr/pgmspace.h>   /* To keep the strings and the configurations in the program memory */
+#include "../COMMON/HAL/LCD/lcd.h"
+#include "../COMMON/MCAL/UART/uart.h"
+#include "../COMMON/HAL/KEYPAD/keypad.h"
+#include "../COMMON/MCAL/TIMER/timer1.h"
+#include "../COMMON/MCAL/TIMER/swtimer.h"
+#include "../COMMON/SERVICE/PROTOCOL/protocol.h"
 
 /*******************************************************************************
 *                              Definitions                                     *
@@ -23,443 +25,597 @@
 #define PASSWORD_MATCH 1
 #define PASSWORD_UNMATCH 0
 
-/*******************************************************************************
-*                             Global Variables                                 *
-*******************************************************************************/
-/* This variable represents the seconds */
-volatile uint8 g_tickTime = 0;
+/* Number of wrong passwords before the alarm or the system error */
+#define PASSWORD_MAX_ATTEMPTS 3
 
-/* it will receive the ACK with 1 or 0 from CONTROL_ECU */
-uint8 control_received_data = 0;
+/* Software timers used by the HMI */
+#define SCREEN_TIMER_ID   0
+#define REQUEST_TIMER_ID  1
+#define KEYPAD_TIMER_ID   2
+#define LCD_TIMER_ID      3
+
+/* Screens times */
+#define MESSAGE_TIME_MS         2000
+#define DOOR_UNLOCKING_TIME_MS  15000
+#define DOOR_WARNING_TIME_MS    1500
+#define DOOR_CLOSING_TIME_MS    3000
+#define DOOR_LOCKING_TIME_MS    15000
+#define ALARM_TIME_MS           60000
 
 /*******************************************************************************
 *                              Types Definitions                               *
 *******************************************************************************/
+/* States of the HMI */
+typedef enum
+{
+	HMI_SETUP_ENTRY,      /* entering the password for the first time */
+	HMI_SETUP_CONFIRM,    /* re-entering the password for the first time */
+	HMI_SETUP_VERIFY,     /* waiting CONTROL_ECU to save the password */
+	HMI_SETUP_RETRY,      /* the two passwords don't match */
+	HMI_MENU,             /* main options */
+	HMI_ENTRY,            /* entering the password to open the door or to change it */
+	HMI_VERIFY,           /* waiting CONTROL_ECU to check the password */
+	HMI_RETRY,            /* the password is wrong */
+	HMI_OPEN_UNLOCKING,   /* door sequence screens */
+	HMI_OPEN_WARNING,
+	HMI_OPEN_CLOSING,
+	HMI_OPEN_LOCKING,
+	HMI_CHANGE_ENTRY,     /* entering the new password */
+	HMI_CHANGE_CONFIRM,   /* re-entering the new password */
+	HMI_CHANGE_VERIFY,    /* waiting CONTROL_ECU to save the new password */
+	HMI_LOCKOUT,          /* the password is wrong 3-times, the alarm is ON */
+	HMI_HALTED            /* the first password couldn't be saved */
+}HMI_State;
+
+/* Events feeding the state machine */
+typedef enum
+{
+	HMI_EV_DIGIT,        /* keypad: a number is pressed, it is in g_key */
+	HMI_EV_ENTER,        /* keypad: KEYPAD_ENTER_KEY */
+	HMI_EV_OPEN_KEY,     /* keypad: '+' */
+	HMI_EV_CHANGE_KEY,   /* keypad: '-' */
+	HMI_EV_TIMEOUT,      /* timer: the time of the current screen ended */
+	HMI_EV_MATCH,        /* UART: CONTROL_ECU replied with PASSWORD_MATCH */
+	HMI_EV_UNMATCH       /* UART: CONTROL_ECU replied with PASSWORD_UNMATCH or didn't reply */
+}HMI_Event;
+
+/* The transition is taken if the action is NULL_PTR or returns TRUE,
+ * otherwise the next transition of the same state and event is tried. */
+typedef struct
+{
+	HMI_State state;
+	HMI_Event event;
+	boolean (*action)(void);
+	HMI_State next;
+}HMI_Transition;
+
 /* Setting the UART configurations */
-UART_configType UART_settings_mc1 = {EIGHT_BIT,EVEN_PARITY,ONE_STOP_BIT,UART_BAUD_RATE};
+const UART_configType UART_settings_mc1 PROGMEM = {EIGHT_BIT,EVEN_PARITY,ONE_STOP_BIT,UART_BAUD_RATE};
 
 /* How the Timer Settings has been Chosen:
  * CPU Frequency (F_CPU) = 8 MHz
- * Prescaler = F_CPU/1024
- * With a prescaler of 1024, the effective clock frequency for Timer1 becomes:
+ * Prescaler = F_CPU/64
+ * With a prescaler of 64, the effective clock frequency for Timer1 becomes:
  * Effective Frequency = F_CPU / Prescaler
- *                     = 8 MHz / 1024 = 7812.5 Hz
+ *                     = 8 MHz / 64 = 125000 Hz
  * Timer Ticks = Timer Frequency * Time
- *             = 7812.5 * 1 = 7812.5
+ *             = 125000 * 0.001 = 125
  * Compare value = Timer Ticks - 1
- *               = 7812.5 - 1 = 7811.5 ~= 7812
- * So, with a compare value of 7811, it means that the Timer1 will overflow exactly once every second. */
+ *               = 125 - 1 = 124
+ * So, with a compare value of 124, the Timer1 compare match happens exactly once every millisecond,
+ * this is the tick of the software timers (SWTIMER_TICK_MS). */
+
+ /* Setting the TIMER configurations. */
+const TIMER1_configType TIMER1_settings_1 PROGMEM = {0,124,F_CPU_64,CTC_OCR1A_TOP};
+
+/*******************************************************************************
+*                             Global Variables                                 *
+*******************************************************************************/
+/* Current state of the HMI */
+HMI_State g_state = HMI_SETUP_ENTRY;
+
+/* The password followed by the re-entered one */
+uint8 g_passwords[2 * PASSWORD_SIZE];
+uint8 g_digits = 0;       /* number of digits in g_passwords */
+uint8 g_digitsLimit = 0;  /* number of digits expected in the current entry */
+
+/* Wrong passwords counter */
+uint8 g_attempts = 0;
+
+/* The menu option chosen by the user: '+' or '-' */
+uint8 g_choice = 0;
+
+/* Last pressed key */
+uint8 g_key = KEYPAD_NO_KEY;
+
+/* Request waiting for its reply from CONTROL_ECU */
+PROTOCOL_Frame g_request;
+PROTOCOL_Parser g_parser;
+uint8 g_requestTries = 0;
+boolean g_requestPending = FALSE;
 
- /* TIMER initialization & setting the TIMER configurations. */
-TIMER1_configType TIMER1_settings_1 = {0,7812,F_CPU_1024,CTC_OCR1A_TOP};
+/* Set by the software timers callbacks */
+volatile boolean g_screenTimeout = FALSE;
+volatile boolean g_requestTimeout = FALSE;
 
 /*******************************************************************************
 *                           Functions Definitions                              *
 *******************************************************************************/
 /* Description:
- * It is the callback function and it increments the ticks of the timer.
+ * Callbacks of the software timers, they are called from the Timer1 ISR
+ * so they only let the main loop know that the time ended.
  */
-void Timer1_callBack(void)
+void screen_TimerCallBack(void)
 {
-	g_tickTime++;
+	g_screenTimeout = TRUE;
+}
+
+void request_TimerCallBack(void)
+{
+	g_requestTimeout = TRUE;
 }
 
 /* Description:
- * Getting the Password from the user & sending it to CONTROL_ECU via UART
+ * it keeps the current screen for the given time then the HMI_EV_TIMEOUT event is raised.
  */
-void input_Password(void)
+void screen_Hold(uint16 time_ms)
 {
-	uint8 key,idx;
+	g_screenTimeout = FALSE;
+	SWTIMER_start(SCREEN_TIMER_ID, SWTIMER_MS_TO_TICKS(time_ms), SWTIMER_ONE_SHOT, screen_TimerCallBack);
+}
 
-	for (idx = 0; idx < PASSWORD_SIZE; idx++)
-	{
-		key = KEYPAD_getPressedKey();
-		if ((key <= 9) && (key >= 0))
-		{
-			LCD_displayCharacter('*');
-			/* send the pressed key to the CONTROL_ECU */
-			UART_sendByte(key);
-		}
-		else
-		{
-			/* to make the UART send five numbers only not including any characters */
-			idx--;
-		}
-		_delay_ms(500); /* Press time */
-	}
+/* Description:
+ * Sending a request frame to CONTROL_ECU without waiting for its reply,
+ * the reply raises HMI_EV_MATCH or HMI_EV_UNMATCH.
+ */
+void send_Request(uint8 type, const uint8 *payload, uint8 length)
+{
+	uint8 idx;
 
-	key = KEYPAD_getPressedKey();
-	if (key == KEYPAD_ENTER_KEY)
+	g_request.type = type;
+	g_request.length = length;
+	for (idx = 0; idx < length; idx++)
 	{
-		/* Receive a byte 1 or 0 to check that the two passwords are matched or not */
-		control_received_data = UART_recieveByte();
-		/* to give the UART time to receive the byte */
-		_delay_ms(500);
+		g_request.payload[idx] = payload[idx];
 	}
+
+	PROTOCOL_sendRequest(&g_request);
+	g_requestTries = 1;
+	g_requestPending = TRUE;
+	g_requestTimeout = FALSE;
+	SWTIMER_start(REQUEST_TIMER_ID, SWTIMER_MS_TO_TICKS(PROTOCOL_REPLY_TIMEOUT_MS), SWTIMER_ONE_SHOT, request_TimerCallBack);
 }
 
+/*******************************************************************************
+*                           State Machine Actions                              *
+*******************************************************************************/
 /* Description:
- * Responsible for changing the password first time and for any time the user wants to change it
+ * Asking the user to enter the password.
  */
-void change_Password(void)
+boolean ask_Password(void)
 {
-	uint8 key, idx;
-	for (idx = 0; idx < PASSWORD_SIZE ; idx++)
-	{
-		/* Get the pressed key number,
-		 * if any switch pressed for more than 500 ms it will considered more than one press */
-		key = KEYPAD_getPressedKey();
+	LCD_clearScreen();
+	LCD_displayString_P(PSTR("Plz Enter Pass:"));
+	LCD_moveCursor(1, 0);
+	g_digits = 0;
+	g_digitsLimit = PASSWORD_SIZE;
+	return TRUE;
+}
 
-		if ((key <= 9) && (key >= 0))
-		{
-			LCD_displayCharacter('*');
-			/* send the pressed key to the CONTROL_ECU */
-			UART_sendByte(key);
-		}
-		else
-		{
-			/* to make the UART send five numbers only not including any characters */
-			idx--;
-		}
-		_delay_ms(500); /* Press time */
+/* Description:
+ * Asking the user to enter the password for the first time.
+ */
+boolean start_Setup(void)
+{
+	g_attempts = 0;
+	return ask_Password();
+}
+
+/* Description:
+ * Asking the user to enter the new password after the old one is checked.
+ */
+boolean ask_NewPassword(void)
+{
+	LCD_clearScreen();
+	LCD_displayString_P(PSTR("Plz enter pass:"));
+	LCD_moveCursor(1, 0);
+	g_digits = 0;
+	g_digitsLimit = PASSWORD_SIZE;
+	return TRUE;
+}
+
+/* Description:
+ * Keeping the entered number, only the expected number of digits is taken.
+ */
+boolean store_Digit(void)
+{
+	if (g_digits < g_digitsLimit)
+	{
+		LCD_displayCharacter('*');
+		g_passwords[g_digits] = g_key;
+		g_digits++;
 	}
+	return TRUE;
+}
 
-	key = KEYPAD_getPressedKey();
-	if (key == KEYPAD_ENTER_KEY)
+/* Description:
+ * Asking the user to enter the same password, the Enter key is ignored until the password is complete.
+ */
+boolean ask_SamePassword(void)
+{
+	if (g_digits != g_digitsLimit)
 	{
-		/* Asking the user to enter the same password */
-		LCD_clearScreen();
-		LCD_displayStringRowColumn(0, 0, "Plz re-enter the");
-		LCD_displayStringRowColumn(1, 0, "Same Pass:");
+		return FALSE;
 	}
+	LCD_clearScreen();
+	LCD_displayStringRowColumn_P(0, 0, PSTR("Plz re-enter the"));
+	LCD_displayStringRowColumn_P(1, 0, PSTR("Same Pass:"));
 	LCD_moveCursor(1, 11);
+	g_digitsLimit = 2 * PASSWORD_SIZE;
+	return TRUE;
+}
 
-	for (idx = 0; idx < PASSWORD_SIZE; idx++)
+/* Description:
+ * Sending the password to CONTROL_ECU to be checked.
+ */
+boolean send_Password(void)
+{
+	if (g_digits != g_digitsLimit)
 	{
-		key = KEYPAD_getPressedKey();
-		if ((key <= 9) && (key >= 0))
-		{
-			LCD_displayCharacter('*');
-			/* send the pressed key to the CONTROL_ECU */
-			UART_sendByte(key);
-		}
-		else
-		{
-			/* to make the UART send five numbers only not including any characters */
-			idx--;
-		}
-		_delay_ms(500); /* Press time */
+		return FALSE;
 	}
+	send_Request(PROTOCOL_MSG_CHECK_PASS, g_passwords, PASSWORD_SIZE);
+	return TRUE;
+}
 
-	key = KEYPAD_getPressedKey();
-	if (key == KEYPAD_ENTER_KEY)
+/* Description:
+ * Sending the two passwords to CONTROL_ECU in one frame to be compared and saved.
+ */
+boolean send_NewPassword(void)
+{
+	if (g_digits != g_digitsLimit)
 	{
-		/* Receive a byte 1 or 0 to check that the two passwords are matched or not */
-		control_received_data = UART_recieveByte();
-		/* to give the UART time to receive the byte */
-		_delay_ms(500);
+		return FALSE;
 	}
+	send_Request(PROTOCOL_MSG_CREATE_PASS, g_passwords, 2 * PASSWORD_SIZE);
+	return TRUE;
+}
+
+/* Description:
+ * Displaying the main options on the screen.
+ */
+boolean show_Menu(void)
+{
+	LCD_clearScreen();
+	LCD_displayStringRowColumn_P(0, 0, PSTR("+ : Open Door"));
+	LCD_displayStringRowColumn_P(1, 0, PSTR("- : Change Pass"));
+	return TRUE;
 }
 
 /* Description:
- * displaying the status while opening the door.
+ * Keeping the chosen option then asking for the password.
  */
-void open_Door(void)
+boolean choose_Option(void)
 {
-	/* Sending the & to let the CONTROL_ECU know that the user wants to use open the door */
-	UART_sendByte('&');
+	g_choice = g_key;
+	g_attempts = 0;
+	return ask_Password();
+}
 
+/* Description:
+ * The password is wrong and the user still has attempts.
+ */
+boolean show_Incorrect(void)
+{
+	g_attempts++;
+	if (g_attempts >= PASSWORD_MAX_ATTEMPTS)
+	{
+		return FALSE;
+	}
 	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "Door is");
-	LCD_displayStringRowColumn(1, 0, "Unlocking");
-	timer1_Delay(15);
+	LCD_displayString_P(PSTR("Incorrect Pass"));
+	LCD_displayStringRowColumn_P(1, 0, PSTR("Pls Try Again"));
+	screen_Hold(MESSAGE_TIME_MS);
+	return TRUE;
+}
 
+/* Description:
+ * The first password couldn't be saved 3-times, DISPLAY an ERROR and stop the system.
+ */
+boolean show_SystemError(void)
+{
 	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "   WARNING!!! ");
-	_delay_ms(1500);
+	LCD_displayString_P(PSTR("  SYSTEM ERROR "));
+	return TRUE;
+}
 
+/* Description:
+ * The chosen option is opening the door: let the CONTROL_ECU know and display its status.
+ */
+boolean open_Door(void)
+{
+	if (g_choice != '+')
+	{
+		return FALSE;
+	}
+	send_Request(PROTOCOL_MSG_OPEN_DOOR, NULL_PTR, 0);
+	LCD_clearScreen();
+	LCD_displayStringRowColumn_P(0, 0, PSTR("Door is"));
+	LCD_displayStringRowColumn_P(1, 0, PSTR("Unlocking"));
+	screen_Hold(DOOR_UNLOCKING_TIME_MS);
+	return TRUE;
+}
+
+boolean show_Warning(void)
+{
 	LCD_clearScreen();
+	LCD_displayStringRowColumn_P(0, 0, PSTR("   WARNING!!! "));
+	screen_Hold(DOOR_WARNING_TIME_MS);
+	return TRUE;
+}
+
+boolean show_Closing(void)
+{
 	/* warning to warn the user that the door will close in 3 seconds */
-	LCD_displayStringRowColumn(0, 0, "Door is");
-	LCD_displayStringRowColumn(1, 0, "Closing");
-	timer1_Delay(3);
+	LCD_clearScreen();
+	LCD_displayStringRowColumn_P(0, 0, PSTR("Door is"));
+	LCD_displayStringRowColumn_P(1, 0, PSTR("Closing"));
+	screen_Hold(DOOR_CLOSING_TIME_MS);
+	return TRUE;
+}
 
+boolean show_Locking(void)
+{
 	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "Door is");
-	LCD_displayStringRowColumn(1, 0, "Locking");
-	timer1_Delay(15);
+	LCD_displayStringRowColumn_P(0, 0, PSTR("Door is"));
+	LCD_displayStringRowColumn_P(1, 0, PSTR("Locking"));
+	screen_Hold(DOOR_LOCKING_TIME_MS);
+	return TRUE;
 }
 
 /* Description:
  * it triggers the alarm when the password does not match the user's password for 3-consecutive times
  */
-void buzzer_Alarm(void)
+boolean buzzer_Alarm(void)
 {
-	/* Sending the $ to let the CONTROL_ECU know that the user wants to use open the door */
-	UART_sendByte('$');
+	/* let the CONTROL_ECU know that the Alarm must be ON */
+	send_Request(PROTOCOL_MSG_ALARM, NULL_PTR, 0);
 	LCD_clearScreen();
-	LCD_displayString("xxxx ERROR xxxx");
+	LCD_displayString_P(PSTR("xxxx ERROR xxxx"));
 	/* wait until the 1 minute */
-	timer1_Delay(60);
+	screen_Hold(ALARM_TIME_MS);
+	return TRUE;
 }
 
-void system_Options(void)
+/*******************************************************************************
+*                           State Machine Table                                *
+*******************************************************************************/
+const HMI_Transition g_transitions[] PROGMEM =
 {
-	uint8 getKey;
-	/* Display the main options on the screen */
-	LCD_clearScreen();
-	LCD_displayStringRowColumn(0, 0, "+ : Open Door");
-	LCD_displayStringRowColumn(1, 0, "- : Change Pass");
+	/* Step.1 : giving the password to the system for the first time */
+	{HMI_SETUP_ENTRY,    HMI_EV_DIGIT,      store_Digit,       HMI_SETUP_ENTRY},
+	{HMI_SETUP_ENTRY,    HMI_EV_ENTER,      ask_SamePassword,  HMI_SETUP_CONFIRM},
+	{HMI_SETUP_CONFIRM,  HMI_EV_DIGIT,      store_Digit,       HMI_SETUP_CONFIRM},
+	{HMI_SETUP_CONFIRM,  HMI_EV_ENTER,      send_NewPassword,  HMI_SETUP_VERIFY},
+	{HMI_SETUP_VERIFY,   HMI_EV_MATCH,      show_Menu,         HMI_MENU},
+	{HMI_SETUP_VERIFY,   HMI_EV_UNMATCH,    show_Incorrect,    HMI_SETUP_RETRY},
+	{HMI_SETUP_VERIFY,   HMI_EV_UNMATCH,    show_SystemError,  HMI_HALTED},
+	{HMI_SETUP_RETRY,    HMI_EV_TIMEOUT,    ask_Password,      HMI_SETUP_ENTRY},
+
+	/* Step.2 : main options */
+	{HMI_MENU,           HMI_EV_OPEN_KEY,   choose_Option,     HMI_ENTRY},
+	{HMI_MENU,           HMI_EV_CHANGE_KEY, choose_Option,     HMI_ENTRY},
+	{HMI_ENTRY,          HMI_EV_DIGIT,      store_Digit,       HMI_ENTRY},
+	{HMI_ENTRY,          HMI_EV_ENTER,      send_Password,     HMI_VERIFY},
+	{HMI_VERIFY,         HMI_EV_MATCH,      open_Door,         HMI_OPEN_UNLOCKING},
+	{HMI_VERIFY,         HMI_EV_MATCH,      ask_NewPassword,   HMI_CHANGE_ENTRY},
+	{HMI_VERIFY,         HMI_EV_UNMATCH,    show_Incorrect,    HMI_RETRY},
+	{HMI_VERIFY,         HMI_EV_UNMATCH,    buzzer_Alarm,      HMI_LOCKOUT},
+	{HMI_RETRY,          HMI_EV_TIMEOUT,    ask_Password,      HMI_ENTRY},
+
+	/* Step.3 : opening the door */
+	{HMI_OPEN_UNLOCKING, HMI_EV_TIMEOUT,    show_Warning,      HMI_OPEN_WARNING},
+	{HMI_OPEN_WARNING,   HMI_EV_TIMEOUT,    show_Closing,      HMI_OPEN_CLOSING},
+	{HMI_OPEN_CLOSING,   HMI_EV_TIMEOUT,    show_Locking,      HMI_OPEN_LOCKING},
+	{HMI_OPEN_LOCKING,   HMI_EV_TIMEOUT,    show_Menu,         HMI_MENU},
+
+	/* Step.4 : changing the password */
+	{HMI_CHANGE_ENTRY,   HMI_EV_DIGIT,      store_Digit,       HMI_CHANGE_ENTRY},
+	{HMI_CHANGE_ENTRY,   HMI_EV_ENTER,      ask_SamePassword,  HMI_CHANGE_CONFIRM},
+	{HMI_CHANGE_CONFIRM, HMI_EV_DIGIT,      store_Digit,       HMI_CHANGE_CONFIRM},
+	{HMI_CHANGE_CONFIRM, HMI_EV_ENTER,      send_NewPassword,  HMI_CHANGE_VERIFY},
+	{HMI_CHANGE_VERIFY,  HMI_EV_MATCH,      show_Menu,         HMI_MENU},
+	{HMI_CHANGE_VERIFY,  HMI_EV_UNMATCH,    show_Menu,         HMI_MENU},
+
+	/* Step.5 : the alarm is ON for 1 minute */
+	{HMI_LOCKOUT,        HMI_EV_TIMEOUT,    show_Menu,         HMI_MENU},
+};
+
+#define HMI_TRANSITIONS_NUM (sizeof(g_transitions) / sizeof(g_transitions[0]))
+
+/* Description:
+ * Taking the first transition of the current state that accepts the event,
+ * events that have no transition in the current state are ignored.
+ */
+void hmi_Dispatch(HMI_Event event)
+{
+	HMI_Transition transition;
+	uint8 idx;
 
-	getKey = KEYPAD_getPressedKey();
-	switch(getKey)
+	for (idx = 0; idx < HMI_TRANSITIONS_NUM; idx++)
 	{
-	case '+':
-		/* Enter the password to be able to open the door */
-		LCD_clearScreen();
-		LCD_displayString("Plz Enter Pass:");
-		LCD_moveCursor(1,0);
-		/* sending # to CONTROL_ECU to be ready for reading the password and check it with the one saved before */
-		UART_sendByte('#');
-		/* take the password from the user */
-		input_Password();
-
-		if (control_received_data == PASSWORD_MATCH)
-		{
-			/* Open the door */
-			open_Door();
-		}
-		/* If the two passwords don't match then repeat step 1 for the first time */
-		else
+		/* The table is in the program memory */
+		memcpy_P(&transition, &g_transitions[idx], sizeof(transition));
+
+		if ((transition.state == g_state) && (transition.event == event))
 		{
-			LCD_clearScreen();
-			LCD_displayString("Incorrect Pass");
-			LCD_displayStringRowColumn(1,0,"Pls Try Again");
-			_delay_ms(2000);
-			LCD_clearScreen();
-			LCD_displayString("Plz Enter Pass:");
-			LCD_moveCursor(1,0);
-			/* Sending the # to let the CONTROL_ECU be ready for reading the password and check on it */
-			UART_sendByte('#');
-			/* take the password from the user */
-			input_Password();
-
-			if (control_received_data == PASSWORD_MATCH)
+			if ((transition.action == NULL_PTR) || (transition.action() == TRUE))
 			{
-				/* Open the door */
-				open_Door();
-			}
-			/* If the two passwords don't match then repeat step 1 for the second time */
-			else
-			{
-				LCD_clearScreen();
-				LCD_displayString("Incorrect Pass");
-				LCD_displayStringRowColumn(1,0,"Pls Try Again");
-				_delay_ms(2000);
-				LCD_clearScreen();
-				LCD_displayString("Plz Enter Pass:");
-				LCD_moveCursor(1,0);
-				/* Sending the # to let the CONTROL_ECU be ready for reading the password and check on it */
-				UART_sendByte('#');
-				/* take the password from the user */
-				input_Password();
-
-				if (control_received_data == PASSWORD_MATCH)
-				{
-					/* Open the door */
-					open_Door();
-				}
-				/* If the two passwords don't match for the last time then turn on the buzzer */
-				else
-				{
-					/* Turn on the BUZZER */
-					buzzer_Alarm();
-				}
+				g_state = transition.next;
+				return;
 			}
 		}
-		break;
-
-	case '-':
-		/* Enter the password to be able to change the password */
-		LCD_clearScreen();
-		LCD_displayString("Plz Enter Pass:");
-		LCD_moveCursor(1, 0);
-		/* Sending the # to let the CONTROL_ECU be ready for reading the password and check on it */
-		UART_sendByte('#');
-		/* take the password from the user */
-		input_Password();
-		if (control_received_data == PASSWORD_MATCH) /* Receive 1 for matched passwords */
+	}
+}
+
+/*******************************************************************************
+*                              Events Sources                                  *
+*******************************************************************************/
+/* Description:
+ * Raising the event of the next key press queued by the keypad scanner, the releases are not needed.
+ */
+boolean keypad_Event(HMI_Event *event)
+{
+	KEYPAD_Event key_event;
+	uint8 key;
+
+	do
+	{
+		if (KEYPAD_getEvent(&key_event) == FALSE)
 		{
-			LCD_clearScreen();
-			LCD_displayString("Plz enter pass:");
-			LCD_moveCursor(1, 0);
-			/* Sending * to make the CONTROL_ECU ready for reading the password and save it */
-			UART_sendByte('*');
-			/* calling the function change_Password to give the password to the system and save it */
-			change_Password();
+			return FALSE;
 		}
-		/* If the two passwords don't match then repeat step 1 for the first time */
-		else
+	} while (key_event.type != KEYPAD_PRESSED);
+
+	key = key_event.key;
+	g_key = key;
+
+	if (key <= 9)
+	{
+		*event = HMI_EV_DIGIT;
+	}
+	else if (key == KEYPAD_ENTER_KEY)
+	{
+		*event = HMI_EV_ENTER;
+	}
+	else if (key == '+')
+	{
+		*event = HMI_EV_OPEN_KEY;
+	}
+	else if (key == '-')
+	{
+		*event = HMI_EV_CHANGE_KEY;
+	}
+	else
+	{
+		return FALSE;
+	}
+	return TRUE;
+}
+
+/* Description:
+ * Raising the event of the reply of the pending request,
+ * the request is sent again if its reply is not received within PROTOCOL_REPLY_TIMEOUT_MS.
+ */
+boolean request_Event(HMI_Event *event)
+{
+	while (PROTOCOL_receiveFrame(&g_parser))
+	{
+		/* Replies to older requests are dropped */
+		if ((g_requestPending == TRUE) && (g_parser.frame.seq == g_request.seq))
 		{
-			LCD_clearScreen();
-			LCD_displayString("Incorrect Pass");
-			LCD_displayStringRowColumn(1,0,"Pls Try Again");
-			_delay_ms(2000);
-			/* Enter the password to be able to change the password */
-			LCD_clearScreen();
-			LCD_displayString("Plz Enter Pass:");
-			LCD_moveCursor(1, 0);
-			/* Sending the # to let the CONTROL_ECU be ready for reading the password and check on it */
-			UART_sendByte('#');
-			/* take the password from the user */
-			input_Password();
-			if (control_received_data == PASSWORD_MATCH) /* Receive 1 for matched passwords */
+			SWTIMER_stop(REQUEST_TIMER_ID);
+			g_requestPending = FALSE;
+			if ((g_parser.frame.type == PROTOCOL_MSG_ACK) && (g_parser.frame.payload[0] == PASSWORD_MATCH))
 			{
-				LCD_clearScreen();
-				LCD_displayString("Plz enter pass:");
-				LCD_moveCursor(1, 0);
-				/* Sending * to make the CONTROL_ECU ready for reading the password and save it */
-				UART_sendByte('*');
-				/* calling the function change_Password to give the password to the system and save it */
-				change_Password();
+				*event = HMI_EV_MATCH;
 			}
-			/* If the two passwords don't match then repeat step 1 for the second time */
 			else
 			{
-				LCD_clearScreen();
-				LCD_displayString("Incorrect Pass");
-				LCD_displayStringRowColumn(1,0,"Pls Try Again");
-				_delay_ms(2000);
-				/* Enter the password to be able to change the password */
-				LCD_clearScreen();
-				LCD_displayString("Plz Enter Pass:");
-				LCD_moveCursor(1, 0);
-				/* Sending the # to let the CONTROL_ECU be ready for reading the password and check on it */
-				UART_sendByte('#');
-				/* take the password from the user */
-				input_Password();
-				/* Sending the letter R to notify CONTROL_ECU that the user wants to change the password */
-				UART_sendByte('R');
-				if (control_received_data == PASSWORD_MATCH) /* Receive 1 for matched passwords */
-				{
-					LCD_clearScreen();
-					LCD_displayString("Plz enter pass:");
-					LCD_moveCursor(1, 0);
-					/* Sending * to make the CONTROL_ECU ready for reading the password and save it */
-					UART_sendByte('*');
-					/* calling the function change_Password to give the password to the system and save it */
-					change_Password();
-				}
-				/* If the two passwords don't match for the last time then turn on the buzzer */
-				else
-				{
-					/* Turn on the BUZZER */
-					buzzer_Alarm();
-				}
+				*event = HMI_EV_UNMATCH;
 			}
+			return TRUE;
 		}
-		break;
 	}
-}
 
-/* Description:
- * it makes a delay in seconds by the use of timer1
- */
-void timer1_Delay(uint8 sec)
-{
-    /* Timer1 initialization */
-    TIMER1_init(&TIMER1_settings_1);
-
-	/* Setting the TIMER1_callBack to be the callback function */
-	TIMER1_setCallBack(Timer1_callBack);
+	if (g_requestTimeout == FALSE)
+	{
+		return FALSE;
+	}
+	g_requestTimeout = FALSE;
 
-	/* reset the timer counter to start counting from 0 */
-	g_tickTime = 0;
+	if (g_requestPending == FALSE)
+	{
+		return FALSE;
+	}
 
-	/* wait until the input seconds */
-	while (g_tickTime <= sec);
+	if (g_requestTries < PROTOCOL_MAX_ATTEMPTS)
+	{
+		PROTOCOL_sendFrame(&g_request);
+		g_requestTries++;
+		SWTIMER_start(REQUEST_TIMER_ID, SWTIMER_MS_TO_TICKS(PROTOCOL_REPLY_TIMEOUT_MS), SWTIMER_ONE_SHOT, request_TimerCallBack);
+		return FALSE;
+	}
 
-	TIMER1_deInit();
+	/* CONTROL_ECU didn't reply */
+	g_requestPending = FALSE;
+	*event = HMI_EV_UNMATCH;
+	return TRUE;
+}
 
-	/* reset the timer counter again to get the needed seconds */
-	g_tickTime = 0;
+/* Description:
+ * Raising the event of the end of the current screen time.
+ */
+boolean screen_Event(HMI_Event *event)
+{
+	if (g_screenTimeout == FALSE)
+	{
+		return FALSE;
+	}
+	g_screenTimeout = FALSE;
+	*event = HMI_EV_TIMEOUT;
+	return TRUE;
 }
+
 /*******************************************************************************
 *                              Main Code                                       *
 *******************************************************************************/
 int main(void)
 {
+	HMI_Event event;
+
     /* enabling interrupt bit "I-bit" */
     SREG |= (1<<7);
 
     /* UART initialization */
-    UART_init(&UART_settings_mc1);
-
-    /* Timer1 initialization */
-    TIMER1_init(&TIMER1_settings_1);
+    UART_init_P(&UART_settings_mc1);
+    PROTOCOL_parserReset(&g_parser);
 
-	/* Setting the TIMER1_callBack to be the callback function */
-	TIMER1_setCallBack(Timer1_callBack);
+    /* Software timers initialization, Timer1 gives them a tick every millisecond */
+    SWTIMER_init_P(&TIMER1_settings_1);
 
 	/* LCD initialization */
 	LCD_init();
 
-	LCD_displayString("Plz Enter Pass:");
-	LCD_moveCursor(1, 0);
-	/* Sending * to make the CONTROL_ECU ready for reading the password and save it */
-	UART_sendByte('*');
-	/* Step.1 : calling the function CHANGE_PASSWORD to give the password to the system and save it */
-	change_Password();
-	/* if the two passwords are matched  we will receive 1 */
-	if (control_received_data == PASSWORD_MATCH)
-	{
-		/* Go to step 2 */
-	}
-	/* if the two passwords don't match repeat step 1 for 2nd time  */
-	else
+#ifdef LCD_ASYNC_MODE
+	/* Sending the queued LCD commands and characters from the Timer1 ISR */
+	SWTIMER_start(LCD_TIMER_ID, SWTIMER_MS_TO_TICKS(LCD_TASK_PERIOD_US / 1000), SWTIMER_PERIODIC, LCD_task);
+#endif
+
+	/* Scanning the keypad periodically from the Timer1 ISR */
+	KEYPAD_init();
+	SWTIMER_start(KEYPAD_TIMER_ID, SWTIMER_MS_TO_TICKS(KEYPAD_SCAN_PERIOD_MS), SWTIMER_PERIODIC, KEYPAD_scanTask);
+
+	/* Step.1 : giving the password to the system */
+	start_Setup();
+	g_state = HMI_SETUP_ENTRY;
+
+	for(;;)
 	{
-		LCD_clearScreen();
-		LCD_displayString("Incorrect Pass");
-		LCD_displayStringRowColumn(1,0,"Pls Try Again");
-		timer1_Delay(2);
-		LCD_clearScreen();
-		LCD_displayString("Plz Enter Pass:");
-		LCD_moveCursor(1, 0);
-		UART_sendByte('*');
-		change_Password();
-		if (control_received_data == PASSWORD_MATCH)
+		if (keypad_Event(&event))
 		{
-			/* Go to step 2 */
+			hmi_Dispatch(event);
 		}
-		/* if the two passwords don't match repeat step 1 for last time  */
-		else
+		if (request_Event(&event))
 		{
-			LCD_clearScreen();
-			LCD_displayString("Incorrect Pass");
-			LCD_displayStringRowColumn(1,0,"Plz Try Again");
-			timer1_Delay(2);
-			LCD_clearScreen();
-			LCD_displayString("Plz Enter Pass:");
-			LCD_moveCursor(1, 0);
-			UART_sendByte('*');
-			change_Password();
-			if (control_received_data == PASSWORD_MATCH)
-			{
-				/* Go to step 2 */
-			}
-			/* if the two passwords don't match again, DISPLAY an ERROR and close the system */
-			else
-			{
-				LCD_clearScreen();
-				LCD_displayString("  SYSTEM ERROR ");
-				timer1_Delay(2);
-				return 0;
-			}
+			hmi_Dispatch(event);
+		}
+		if (screen_Event(&event))
+		{
+			hmi_Dispatch(event);
 		}
-	}
 
-	for(;;)
-	{
-		system_Options();
+		/* Send only what the events changed on the screen */
+		LCD_flush();
 	}
 }